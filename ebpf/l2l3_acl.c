@@ -70,8 +70,13 @@ struct {
     __uint(pinning, LIBBPF_PIN_BY_NAME);
 } tx_port SEC(".maps");
 
+// Shared counters updated atomically, -DCOUNTER_PERCPU for per-CPU counters (sum over CPUs when reading)
 struct {
+#ifdef COUNTER_PERCPU
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+#else
     __uint(type, BPF_MAP_TYPE_ARRAY);
+#endif
     __uint(key_size, 4);
     __uint(value_size, sizeof(struct counter_val));
     __uint(max_entries, 100);
@@ -309,8 +314,13 @@ int xdp_func(struct xdp_md *ctx)
     // Control block
     struct counter_val *ctr_val = bpf_map_lookup_elem(&in_pkts, &in_port);
     if (ctr_val != NULL) {
+#ifdef COUNTER_PERCPU
+        ctr_val->bytes += (__u32) pkt_len;
+        ctr_val->packets += 1;
+#else
 	__sync_fetch_and_add(&(ctr_val->bytes), (__u32) pkt_len);
         __sync_fetch_and_add(&(ctr_val->packets), 1);
+#endif
     }
 
 
@@ -367,7 +377,24 @@ int xdp_func(struct xdp_md *ctx)
             return XDP_DROP;
     }
 
-    // unfortunately it seems that data_meta cannot be used
+    struct bridged_metadata *meta;
+#ifndef BRIDGE_IN_PACKET
+    // data_meta is kept in the xdp_frame across the devmap redirect, but only if the driver
+    // supports it; otherwise the metadata is prepended to the packet
+    ret = bpf_xdp_adjust_meta(ctx, -(int)sizeof(struct bridged_metadata));
+    if (ret == 0) {
+        data = (void *)(unsigned long)ctx->data;
+        meta = (void *)(unsigned long)ctx->data_meta;
+        if ((void *)(meta + 1) > data)
+            return XDP_ABORTED;
+
+        meta->ingress_port = in_port;
+        meta->vlan_id = vlanhdr_vlan_id;
+
+        return bpf_redirect_map(&tx_port, out_port, 0);
+    }
+#endif
+
     ret = bpf_xdp_adjust_head(ctx, -(int)sizeof(struct bridged_metadata));
     if (ret < 0)
 	return XDP_ABORTED;
@@ -375,7 +402,7 @@ int xdp_func(struct xdp_md *ctx)
     data = (void *)(unsigned long)ctx->data;
     data_end = (void *)(unsigned long)ctx->data_end;
 
-    struct bridged_metadata *meta = data;
+    meta = data;
     if (data + sizeof(struct bridged_metadata) > data_end)
 		return XDP_ABORTED;
 
@@ -389,17 +416,29 @@ SEC("xdp_devmap/xdp-egress")
 int xdp_func_egress(struct xdp_md *ctx) {
     void *data = (void *)(unsigned long)ctx->data;
     void *data_end = (void *)(unsigned long)ctx->data_end;
-
-    struct bridged_metadata *meta = data;
-    if (meta + 1 > data_end)
-                return XDP_ABORTED;
-
-    __u32 in_port = meta->ingress_port;
-    __u32 vlan_id = meta->vlan_id;
-
-    int ret = bpf_xdp_adjust_head(ctx, sizeof(struct bridged_metadata));
-    if (ret < 0)
-        return XDP_ABORTED;
+    __u32 in_port;
+    __u32 vlan_id;
+    int ret;
+
+#ifndef BRIDGE_IN_PACKET
+    struct bridged_metadata *meta = (void *)(unsigned long)ctx->data_meta;
+    if ((void *)(meta + 1) <= data) {
+        in_port = meta->ingress_port;
+        vlan_id = meta->vlan_id;
+    } else
+#endif
+    {
+        struct bridged_metadata *meta = data;
+        if (meta + 1 > data_end)
+                    return XDP_ABORTED;
+
+        in_port = meta->ingress_port;
+        vlan_id = meta->vlan_id;
+
+        ret = bpf_xdp_adjust_head(ctx, sizeof(struct bridged_metadata));
+        if (ret < 0)
+            return XDP_ABORTED;
+    }
 
     if (ctx->egress_ifindex == in_port) {
         return XDP_DROP;
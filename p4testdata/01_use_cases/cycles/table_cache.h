@@ -0,0 +1,39 @@
+/*
+ * Helpers shared by the generation-invalidated caches (upf/table-caching-gen and
+ * l2l3-acl/flow-cache). Included after ebpf_kernel.h and psa.h.
+ */
+#ifndef P4TESTDATA_CYCLES_TABLE_CACHE_H
+#define P4TESTDATA_CYCLES_TABLE_CACHE_H
+
+#ifndef TABLE_CACHE_SKETCH_WORDS
+#define TABLE_CACHE_SKETCH_WORDS 1024
+#endif
+
+/* per CPU, read by scripts/table_cache_stats.py; entries with an old generation are misses */
+struct table_cache_stats {
+    u64 hits;
+    u64 misses;
+};
+
+static __always_inline
+u32 table_cache_key_hash(const void *key, u32 size) {
+    u32 hash = 2166136261;
+    #pragma clang loop unroll(disable)
+    for (u32 i = 0; i < size / 4; i++) {
+        hash = (hash ^ ((const u32 *) key)[i]) * 16777619;
+    }
+    return hash;
+}
+static __always_inline
+void table_cache_sketch_update(void *map, const void *key, u32 size) {
+    /* Linear counting bitmap used by the control plane to estimate flow cardinality */
+    u32 hash = table_cache_key_hash(key, size);
+    u32 word_idx = (hash >> 6) % TABLE_CACHE_SKETCH_WORDS;
+    u64 bit = 1ULL << (hash & 63);
+    u64 *word = BPF_MAP_LOOKUP_ELEM(*map, &word_idx);
+    if (word != NULL && (*word & bit) == 0) {
+        *word |= bit;
+    }
+}
+
+#endif
@@ -0,0 +1,289 @@
+#
+# Minimal wrappers of the bpf(2) syscall used by the table loading and benchmark scripts.
+# Only the commands needed to open pinned maps, walk them and write them in bulk, and to find
+# and run the programs of a pipeline are covered.
+#
+
+import ctypes
+import os
+
+BPF_MAP_CREATE = 0
+BPF_MAP_LOOKUP_ELEM = 1
+BPF_MAP_UPDATE_ELEM = 2
+BPF_MAP_DELETE_ELEM = 3
+BPF_MAP_GET_NEXT_KEY = 4
+BPF_OBJ_PIN = 6
+BPF_OBJ_GET = 7
+BPF_PROG_TEST_RUN = 10
+BPF_PROG_GET_NEXT_ID = 11
+BPF_PROG_GET_FD_BY_ID = 13
+BPF_MAP_GET_FD_BY_ID = 14
+BPF_OBJ_GET_INFO_BY_FD = 15
+BPF_BTF_GET_FD_BY_ID = 19
+BPF_MAP_UPDATE_BATCH = 26
+
+BPF_MAP_TYPE_HASH = 1
+BPF_MAP_TYPE_ARRAY = 2
+BPF_MAP_TYPE_PROG_ARRAY = 3
+BPF_MAP_TYPE_PERCPU_HASH = 5
+BPF_MAP_TYPE_PERCPU_ARRAY = 6
+BPF_MAP_TYPE_LPM_TRIE = 11
+BPF_MAP_TYPE_ARRAY_OF_MAPS = 12
+BPF_MAP_TYPE_DEVMAP_HASH = 25
+
+BPF_ANY = 0
+BPF_NOEXIST = 1
+
+BPF_F_TEST_RUN_ON_CPU = 1 << 0
+BPF_F_TEST_XDP_LIVE_FRAMES = 1 << 1
+
+NR_BPF = {"x86_64": 321, "aarch64": 280}
+
+_libc = ctypes.CDLL(None, use_errno=True)
+
+
+class MapInfo(ctypes.Structure):
+    # struct bpf_map_info, up to btf_value_type_id
+    _fields_ = [("type", ctypes.c_uint32), ("id", ctypes.c_uint32), ("key_size", ctypes.c_uint32),
+                ("value_size", ctypes.c_uint32), ("max_entries", ctypes.c_uint32),
+                ("map_flags", ctypes.c_uint32), ("name", ctypes.c_char * 16), ("ifindex", ctypes.c_uint32),
+                ("btf_vmlinux_value_type_id", ctypes.c_uint32), ("netns_dev", ctypes.c_uint64),
+                ("netns_ino", ctypes.c_uint64), ("btf_id", ctypes.c_uint32),
+                ("btf_key_type_id", ctypes.c_uint32), ("btf_value_type_id", ctypes.c_uint32)]
+
+
+class ProgInfo(ctypes.Structure):
+    # struct bpf_prog_info, up to verified_insns (0 before Linux 5.16)
+    _fields_ = [("type", ctypes.c_uint32), ("id", ctypes.c_uint32), ("tag", ctypes.c_uint8 * 8),
+                ("jited_prog_len", ctypes.c_uint32), ("xlated_prog_len", ctypes.c_uint32),
+                ("jited_prog_insns", ctypes.c_uint64), ("xlated_prog_insns", ctypes.c_uint64),
+                ("load_time", ctypes.c_uint64), ("created_by_uid", ctypes.c_uint32),
+                ("nr_map_ids", ctypes.c_uint32), ("map_ids", ctypes.c_uint64), ("name", ctypes.c_char * 16),
+                ("ifindex", ctypes.c_uint32), ("gpl_compatible", ctypes.c_uint32),
+                ("netns_dev", ctypes.c_uint64), ("netns_ino", ctypes.c_uint64),
+                ("nr_jited_ksyms", ctypes.c_uint32), ("nr_jited_func_lens", ctypes.c_uint32),
+                ("jited_ksyms", ctypes.c_uint64), ("jited_func_lens", ctypes.c_uint64),
+                ("btf_id", ctypes.c_uint32), ("func_info_rec_size", ctypes.c_uint32),
+                ("func_info", ctypes.c_uint64), ("nr_func_info", ctypes.c_uint32),
+                ("nr_line_info", ctypes.c_uint32), ("line_info", ctypes.c_uint64),
+                ("jited_line_info", ctypes.c_uint64), ("nr_jited_line_info", ctypes.c_uint32),
+                ("line_info_rec_size", ctypes.c_uint32), ("jited_line_info_rec_size", ctypes.c_uint32),
+                ("nr_prog_tags", ctypes.c_uint32), ("prog_tags", ctypes.c_uint64),
+                ("run_time_ns", ctypes.c_uint64), ("run_cnt", ctypes.c_uint64),
+                ("recursion_misses", ctypes.c_uint64), ("verified_insns", ctypes.c_uint32)]
+
+
+def possible_cpus():
+    """Number of possible CPUs, i.e. of values returned by lookups in per-CPU maps."""
+    with open("/sys/devices/system/cpu/possible") as f:
+        return max(int(r.split("-")[-1]) for r in f.read().strip().split(",")) + 1
+
+
+def _bpf(cmd, attr):
+    ret = _libc.syscall(NR_BPF[os.uname().machine], cmd, ctypes.byref(attr), ctypes.sizeof(attr))
+    if ret < 0:
+        errno = ctypes.get_errno()
+        raise OSError(errno, "bpf({}): {}".format(cmd, os.strerror(errno)))
+    return ret
+
+
+def obj_get(path):
+    class Attr(ctypes.Structure):
+        _fields_ = [("pathname", ctypes.c_uint64), ("bpf_fd", ctypes.c_uint32), ("file_flags", ctypes.c_uint32)]
+    c_path = ctypes.create_string_buffer(path.encode())
+    return _bpf(BPF_OBJ_GET, Attr(ctypes.addressof(c_path), 0, 0))
+
+
+def obj_pin(fd, path):
+    class Attr(ctypes.Structure):
+        _fields_ = [("pathname", ctypes.c_uint64), ("bpf_fd", ctypes.c_uint32), ("file_flags", ctypes.c_uint32)]
+    c_path = ctypes.create_string_buffer(path.encode())
+    _bpf(BPF_OBJ_PIN, Attr(ctypes.addressof(c_path), fd, 0))
+
+
+def map_fd_by_id(map_id):
+    class Attr(ctypes.Structure):
+        _fields_ = [("map_id", ctypes.c_uint32), ("next_id", ctypes.c_uint32), ("open_flags", ctypes.c_uint32)]
+    return _bpf(BPF_MAP_GET_FD_BY_ID, Attr(map_id, 0, 0))
+
+
+def btf_fd_by_id(btf_id):
+    class Attr(ctypes.Structure):
+        _fields_ = [("btf_id", ctypes.c_uint32), ("next_id", ctypes.c_uint32), ("open_flags", ctypes.c_uint32)]
+    return _bpf(BPF_BTF_GET_FD_BY_ID, Attr(btf_id, 0, 0))
+
+
+def prog_fd_by_id(prog_id):
+    class Attr(ctypes.Structure):
+        _fields_ = [("prog_id", ctypes.c_uint32), ("next_id", ctypes.c_uint32), ("open_flags", ctypes.c_uint32)]
+    return _bpf(BPF_PROG_GET_FD_BY_ID, Attr(prog_id, 0, 0))
+
+
+def prog_ids():
+    """Yield IDs of all loaded programs with BPF_PROG_GET_NEXT_ID."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("start_id", ctypes.c_uint32), ("next_id", ctypes.c_uint32), ("open_flags", ctypes.c_uint32)]
+    attr = Attr(0, 0, 0)
+    while True:
+        try:
+            _bpf(BPF_PROG_GET_NEXT_ID, attr)
+        except FileNotFoundError:
+            return
+        attr.start_id = attr.next_id
+        yield attr.next_id
+
+
+def prog_info(fd, max_maps=64):
+    """struct bpf_prog_info of a program and the IDs of the maps it uses."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("bpf_fd", ctypes.c_uint32), ("info_len", ctypes.c_uint32), ("info", ctypes.c_uint64)]
+    map_ids = (ctypes.c_uint32 * max_maps)()
+    info = ProgInfo()
+    info.nr_map_ids = max_maps
+    info.map_ids = ctypes.addressof(map_ids)
+    _bpf(BPF_OBJ_GET_INFO_BY_FD, Attr(fd, ctypes.sizeof(info), ctypes.addressof(info)))
+    return info, list(map_ids[:min(info.nr_map_ids, max_maps)])
+
+
+def prog_test_run(fd, data, repeat=1, flags=0, batch_size=0):
+    """Run a program on a packet with BPF_PROG_TEST_RUN. Returns (retval, average duration in ns).
+    The output packet is not copied back."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("prog_fd", ctypes.c_uint32), ("retval", ctypes.c_uint32), ("data_size_in", ctypes.c_uint32),
+                    ("data_size_out", ctypes.c_uint32), ("data_in", ctypes.c_uint64), ("data_out", ctypes.c_uint64),
+                    ("repeat", ctypes.c_uint32), ("duration", ctypes.c_uint32), ("ctx_size_in", ctypes.c_uint32),
+                    ("ctx_size_out", ctypes.c_uint32), ("ctx_in", ctypes.c_uint64), ("ctx_out", ctypes.c_uint64),
+                    ("flags", ctypes.c_uint32), ("cpu", ctypes.c_uint32), ("batch_size", ctypes.c_uint32)]
+    d = ctypes.create_string_buffer(data, len(data))
+    attr = Attr(prog_fd=fd, data_size_in=len(data), data_in=ctypes.addressof(d), repeat=repeat, flags=flags,
+                batch_size=batch_size)
+    _bpf(BPF_PROG_TEST_RUN, attr)
+    return attr.retval, attr.duration
+
+
+def map_info(fd):
+    class Attr(ctypes.Structure):
+        _fields_ = [("bpf_fd", ctypes.c_uint32), ("info_len", ctypes.c_uint32), ("info", ctypes.c_uint64)]
+    info = MapInfo()
+    _bpf(BPF_OBJ_GET_INFO_BY_FD, Attr(fd, ctypes.sizeof(info), ctypes.addressof(info)))
+    return info
+
+
+def map_create(map_type, key_size, value_size, max_entries, map_flags=0, name=b"", btf=(0, 0, 0)):
+    """btf: (BTF fd, key type ID, value type ID), e.g. to create a map like an existing one."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("map_type", ctypes.c_uint32), ("key_size", ctypes.c_uint32), ("value_size", ctypes.c_uint32),
+                    ("max_entries", ctypes.c_uint32), ("map_flags", ctypes.c_uint32),
+                    ("inner_map_fd", ctypes.c_uint32), ("numa_node", ctypes.c_uint32),
+                    ("map_name", ctypes.c_char * 16), ("map_ifindex", ctypes.c_uint32),
+                    ("btf_fd", ctypes.c_uint32), ("btf_key_type_id", ctypes.c_uint32),
+                    ("btf_value_type_id", ctypes.c_uint32)]
+    return _bpf(BPF_MAP_CREATE, Attr(map_type, key_size, value_size, max_entries, map_flags, 0, 0, name[:15], 0,
+                                     *btf))
+
+
+class _ElemAttr(ctypes.Structure):
+    _fields_ = [("map_fd", ctypes.c_uint32), ("pad", ctypes.c_uint32), ("key", ctypes.c_uint64),
+                ("value", ctypes.c_uint64), ("flags", ctypes.c_uint64)]
+
+
+def map_lookup(fd, key, value_size):
+    k = ctypes.create_string_buffer(key, len(key))
+    v = ctypes.create_string_buffer(value_size)
+    try:
+        _bpf(BPF_MAP_LOOKUP_ELEM, _ElemAttr(fd, 0, ctypes.addressof(k), ctypes.addressof(v), 0))
+    except FileNotFoundError:
+        return None
+    return v.raw
+
+
+def map_update(fd, key, value, flags=BPF_ANY):
+    k = ctypes.create_string_buffer(key, len(key))
+    v = ctypes.create_string_buffer(value, len(value))
+    _bpf(BPF_MAP_UPDATE_ELEM, _ElemAttr(fd, 0, ctypes.addressof(k), ctypes.addressof(v), flags))
+
+
+def map_delete(fd, key):
+    k = ctypes.create_string_buffer(key, len(key))
+    _bpf(BPF_MAP_DELETE_ELEM, _ElemAttr(fd, 0, ctypes.addressof(k), 0, 0))
+
+
+def map_keys(fd, key_size):
+    """Yield all keys of a map with BPF_MAP_GET_NEXT_KEY."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("map_fd", ctypes.c_uint32), ("pad", ctypes.c_uint32), ("key", ctypes.c_uint64),
+                    ("next_key", ctypes.c_uint64)]
+    key = None
+    next_key = ctypes.create_string_buffer(key_size)
+    while True:
+        try:
+            _bpf(BPF_MAP_GET_NEXT_KEY, Attr(fd, 0, ctypes.addressof(key) if key else 0, ctypes.addressof(next_key)))
+        except FileNotFoundError:
+            return
+        key = ctypes.create_string_buffer(next_key.raw, key_size)
+        yield key.raw
+
+
+def map_update_batch(fd, keys, values, flags=BPF_ANY):
+    """Write all keys/values (lists of bytes) with BPF_MAP_UPDATE_BATCH. Map types without
+    batch support are written element by element. Returns True if batching was used."""
+    class Attr(ctypes.Structure):
+        _fields_ = [("in_batch", ctypes.c_uint64), ("out_batch", ctypes.c_uint64), ("keys", ctypes.c_uint64),
+                    ("values", ctypes.c_uint64), ("count", ctypes.c_uint32), ("map_fd", ctypes.c_uint32),
+                    ("elem_flags", ctypes.c_uint64), ("flags", ctypes.c_uint64)]
+    if not keys:
+        return True
+    k = ctypes.create_string_buffer(b"".join(keys), len(keys) * len(keys[0]))
+    v = ctypes.create_string_buffer(b"".join(values), len(values) * len(values[0]))
+    attr = Attr(0, 0, ctypes.addressof(k), ctypes.addressof(v), len(keys), fd, flags, 0)
+    try:
+        _bpf(BPF_MAP_UPDATE_BATCH, attr)
+        return True
+    except OSError as e:
+        # EINVAL/ENOTSUPP: no batch operations for this map type (e.g. older LPM tries)
+        if e.errno not in (22, 95, 524) or attr.count != 0:
+            raise
+    for key, value in zip(keys, values):
+        map_update(fd, key, value, flags)
+    return False
+
+
+def pipeline_progs(pipe):
+    """Map program name -> (id, struct bpf_prog_info) of the programs of a pipeline: the ones pinned
+    in /sys/fs/bpf/pipeline<pipe> by 'psabpf-ctl pipeline load' and the ones using its pinned maps
+    (e.g. tail call stages). Names are truncated to 15 characters like in 'bpftool prog'."""
+    root = "/sys/fs/bpf/pipeline{}".format(pipe)
+    pipe_map_ids = set()
+    for name in os.listdir(os.path.join(root, "maps")):
+        fd = obj_get(os.path.join(root, "maps", name))
+        try:
+            pipe_map_ids.add(map_info(fd).id)
+        finally:
+            os.close(fd)
+
+    pinned = {}
+    for name in os.listdir(root):
+        if os.path.isdir(os.path.join(root, name)):
+            continue
+        fd = obj_get(os.path.join(root, name))
+        try:
+            info = prog_info(fd)[0]
+        finally:
+            os.close(fd)
+        pinned[info.name.decode()] = (info.id, info)
+
+    progs = {}
+    for prog_id in prog_ids():
+        try:
+            fd = prog_fd_by_id(prog_id)
+        except FileNotFoundError:
+            continue
+        try:
+            info, map_ids = prog_info(fd)
+        finally:
+            os.close(fd)
+        if pipe_map_ids.intersection(map_ids):
+            # IDs grow, the last one is the most recently loaded program
+            progs[info.name.decode()] = (prog_id, info)
+    progs.update(pinned)
+    return progs
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+#
+# Read PSA-eBPF counters, summing per-CPU counters over all CPUs.
+#
+# Usage:
+#   sudo python3 scripts/counter_get.py counter get pipe <ID> <COUNTER> [key <INDEX>]
+#   sudo python3 scripts/counter_get.py counter prune pipe <ID> <TABLE>
+#
+# Takes the arguments of 'psabpf-ctl counter get' and prints the counter in the same JSON
+# layout. Besides the maps of indirect counters (BPF_MAP_TYPE_ARRAY/HASH), COUNTER can be
+# a per-CPU counter map (BPF_MAP_TYPE_PERCPU_ARRAY/PERCPU_HASH), e.g. ingress_in_pkts of
+# p4testdata/01_use_cases/cycles/l2l3-acl/percpu-counters, or a per-CPU side map of a
+# direct counter, e.g. egress_tbl_vlan_egress_out_pkts (keyed like its table).
+# Array entries with all counts equal to 0 are not printed unless INDEX is given.
+# Field names and sizes are taken from the BTF of the pipeline.
+# 'counter prune' deletes the entries of the per-CPU side maps of TABLE (<TABLE>_<counter>,
+# BPF_MAP_TYPE_PERCPU_HASH keyed like the table) whose key is no longer in the table, so that
+# a re-added entry starts from 0. scripts/table_ctl.sh runs it around table adds and deletes.
+
+import json
+import os
+import sys
+
+import bpfsys
+from table_load import BTF
+
+PERCPU_TYPES = (bpfsys.BPF_MAP_TYPE_PERCPU_ARRAY, bpfsys.BPF_MAP_TYPE_PERCPU_HASH)
+ARRAY_TYPES = (bpfsys.BPF_MAP_TYPE_ARRAY, bpfsys.BPF_MAP_TYPE_PERCPU_ARRAY)
+
+
+def unpack(data, members):
+    return {name: int.from_bytes(data[offset:offset + size], sys.byteorder) for name, offset, size, _ in members}
+
+
+def read_entry(fd, info, key, members):
+    if info.type not in PERCPU_TYPES:
+        data = bpfsys.map_lookup(fd, key, info.value_size)
+        return unpack(data, members) if data is not None else None
+    # per-CPU values are padded to 8 bytes
+    stride = (info.value_size + 7) // 8 * 8
+    cpus = bpfsys.possible_cpus()
+    data = bpfsys.map_lookup(fd, key, stride * cpus)
+    if data is None:
+        return None
+    total = {name: 0 for name, _, _, _ in members}
+    for cpu in range(cpus):
+        for name, count in unpack(data[cpu * stride:(cpu + 1) * stride], members).items():
+            total[name] += count
+    return total
+
+
+def prune(maps_dir, table):
+    """Delete side map entries of direct counters of table that have no table entry."""
+    if not os.path.exists(os.path.join(maps_dir, table)):
+        return 0
+    fd = bpfsys.obj_get(os.path.join(maps_dir, table))
+    try:
+        info = bpfsys.map_info(fd)
+    finally:
+        os.close(fd)
+    side_maps = []
+    for name in os.listdir(maps_dir):
+        if not name.startswith(table + "_"):
+            continue
+        fd = bpfsys.obj_get(os.path.join(maps_dir, name))
+        try:
+            side = bpfsys.map_info(fd)
+        finally:
+            os.close(fd)
+        if side.type == bpfsys.BPF_MAP_TYPE_PERCPU_HASH and side.key_size == info.key_size:
+            side_maps.append(name)
+    # the table keys are read only for tables with direct counters
+    if not side_maps:
+        return 0
+
+    fd = bpfsys.obj_get(os.path.join(maps_dir, table))
+    try:
+        keys = set(bpfsys.map_keys(fd, info.key_size))
+    finally:
+        os.close(fd)
+    deleted = 0
+    for name in side_maps:
+        fd = bpfsys.obj_get(os.path.join(maps_dir, name))
+        try:
+            for key in [k for k in bpfsys.map_keys(fd, info.key_size) if k not in keys]:
+                try:
+                    bpfsys.map_delete(fd, key)
+                    deleted += 1
+                except FileNotFoundError:
+                    pass
+        finally:
+            os.close(fd)
+    return deleted
+
+
+def main():
+    argv = sys.argv[1:]
+    if argv[:3] == ["counter", "prune", "pipe"] and len(argv) == 5:
+        prune("/sys/fs/bpf/pipeline{}/maps".format(argv[3]), argv[4])
+        return 0
+    if argv[:3] != ["counter", "get", "pipe"] or len(argv) not in (5, 7) or (len(argv) == 7 and argv[5] != "key"):
+        print("Usage: {} counter get pipe <ID> <COUNTER> [key <INDEX>]".format(sys.argv[0]), file=sys.stderr)
+        print("       {} counter prune pipe <ID> <TABLE>".format(sys.argv[0]), file=sys.stderr)
+        return 1
+    name = argv[4]
+    fd = bpfsys.obj_get(os.path.join("/sys/fs/bpf/pipeline{}/maps".format(argv[3]), name))
+    info = bpfsys.map_info(fd)
+    btf = BTF(info.btf_id)
+    key_members = btf.members(info.btf_key_type_id) if btf.resolve(info.btf_key_type_id)["kind"] == "STRUCT" \
+        else [("index", 0, info.key_size, info.btf_key_type_id)]
+    members = btf.members(info.btf_value_type_id)
+
+    if len(argv) == 7:
+        keys = [int(argv[6], 0).to_bytes(info.key_size, sys.byteorder)]
+    else:
+        keys = bpfsys.map_keys(fd, info.key_size)
+
+    entries = []
+    for key in keys:
+        value = read_entry(fd, info, key, members)
+        if value is None or (len(argv) == 5 and info.type in ARRAY_TYPES and not any(value.values())):
+            continue
+        entries.append({"key": {k: hex(v) for k, v in unpack(key, key_members).items()},
+                        "value": {k: hex(v) for k, v in value.items()}})
+    os.close(fd)
+
+    counter_type = "PACKETS_AND_BYTES" if len(members) > 1 else members[0][0].upper()
+    print(json.dumps({name: {"type": counter_type, "entries": entries}}, indent=4))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,212 @@
+/*
+ * Drain PSA-eBPF digests and report the sustained rate.
+ *
+ * Usage: digest_consumer [-d DURATION] [-t TIMEOUT_MS] [-p] PIN_PATH
+ *
+ * Digests are drained for DURATION seconds (default 10) with digest_consumer__poll()
+ * (see digest_consumer.h), waiting up to TIMEOUT_MS (default 100) for new ones.
+ * -p prints every digest as hex. At the end prints: <digests> <seconds> <digests per second>
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/epoll.h>
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#include "digest_consumer.h"
+
+/* back-off between polls of an empty queue */
+#define QUEUE_POLL_US 50
+
+struct digest_consumer {
+    int map_fd;
+    int epoll_fd;
+    struct ring_buffer *rb;
+    void *msg;
+    size_t msg_size;
+    digest_cb cb;
+    void *ctx;
+    int count;
+};
+
+static int ringbuf_sample(void *ctx, void *data, size_t size)
+{
+    struct digest_consumer *c = ctx;
+
+    c->count++;
+    return c->cb ? c->cb(c->ctx, data, size) : 0;
+}
+
+struct digest_consumer *digest_consumer__open(const char *pin_path, digest_cb cb, void *ctx)
+{
+    struct bpf_map_info info;
+    __u32 info_len = sizeof(info);
+    struct digest_consumer *c = calloc(1, sizeof(*c));
+    if (!c)
+        return NULL;
+
+    c->cb = cb;
+    c->ctx = ctx;
+    c->epoll_fd = -1;
+    c->map_fd = bpf_obj_get(pin_path);
+    if (c->map_fd < 0)
+        goto err;
+
+    memset(&info, 0, sizeof(info));
+    if (bpf_obj_get_info_by_fd(c->map_fd, &info, &info_len))
+        goto err;
+
+    if (info.type == BPF_MAP_TYPE_RINGBUF) {
+        c->rb = ring_buffer__new(c->map_fd, ringbuf_sample, c, NULL);
+        if (!c->rb)
+            goto err;
+        c->epoll_fd = ring_buffer__epoll_fd(c->rb);
+    } else if (info.type == BPF_MAP_TYPE_QUEUE) {
+        c->msg_size = info.value_size;
+        c->msg = malloc(c->msg_size);
+        if (!c->msg)
+            goto err;
+    } else {
+        errno = EINVAL;
+        goto err;
+    }
+    return c;
+
+err:
+    digest_consumer__free(c);
+    return NULL;
+}
+
+int digest_consumer__epoll_fd(const struct digest_consumer *c)
+{
+    return c->epoll_fd;
+}
+
+int digest_consumer__poll(struct digest_consumer *c, int timeout_ms)
+{
+    c->count = 0;
+
+    if (c->rb) {
+        struct epoll_event event;
+        /* the data path wakes us up only every DIGEST_WAKEUP_BYTES, drain on timeout too */
+        if (epoll_wait(c->epoll_fd, &event, 1, timeout_ms) < 0 && errno != EINTR)
+            return -errno;
+        int ret = ring_buffer__consume(c->rb);
+        if (ret < 0)
+            return ret;
+        return c->count;
+    }
+
+    /*
+     * A queue has no wakeup: poll it with a short back-off (QUEUE_POLL_US) until timeout_ms,
+     * so that the 100-entry queue is drained about as quickly as the ring buffer instead of
+     * overflowing while we sleep.
+     */
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        while (bpf_map_lookup_and_delete_elem(c->map_fd, NULL, c->msg) == 0) {
+            c->count++;
+            if (c->cb) {
+                int ret = c->cb(c->ctx, c->msg, c->msg_size);
+                if (ret < 0)
+                    return ret;
+            }
+        }
+        if (errno != ENOENT)
+            return -errno;
+        if (c->count > 0)
+            break;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 >= timeout_ms)
+            break;
+        usleep(QUEUE_POLL_US);
+    }
+    return c->count;
+}
+
+void digest_consumer__free(struct digest_consumer *c)
+{
+    if (!c)
+        return;
+    ring_buffer__free(c->rb);
+    if (c->map_fd >= 0)
+        close(c->map_fd);
+    free(c->msg);
+    free(c);
+}
+
+static int print_digest(void *ctx, const void *msg, size_t size)
+{
+    const unsigned char *bytes = msg;
+
+    for (size_t i = 0; i < size; i++)
+        printf("%02x", bytes[i]);
+    printf("\n");
+    return 0;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    int duration = 10;
+    int timeout_ms = 100;
+    digest_cb cb = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:t:p")) != -1) {
+        switch (opt) {
+        case 'd':
+            duration = atoi(optarg);
+            break;
+        case 't':
+            timeout_ms = atoi(optarg);
+            break;
+        case 'p':
+            cb = print_digest;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-d DURATION] [-t TIMEOUT_MS] [-p] PIN_PATH\n", argv[0]);
+            return EINVAL;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "Usage: %s [-d DURATION] [-t TIMEOUT_MS] [-p] PIN_PATH\n", argv[0]);
+        return EINVAL;
+    }
+
+    struct digest_consumer *c = digest_consumer__open(argv[optind], cb, NULL);
+    if (!c) {
+        fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+        return -1;
+    }
+
+    unsigned long long total = 0;
+    double start = now();
+    double elapsed = 0;
+    while (elapsed < duration) {
+        int ret = digest_consumer__poll(c, timeout_ms);
+        if (ret < 0) {
+            fprintf(stderr, "poll: %s\n", strerror(-ret));
+            break;
+        }
+        total += ret;
+        elapsed = now() - start;
+    }
+    digest_consumer__free(c);
+
+    printf("%llu %.2f %.0f\n", total, elapsed, total / elapsed);
+    return 0;
+}
@@ -0,0 +1,32 @@
+#ifndef DIGEST_CONSUMER_H
+#define DIGEST_CONSUMER_H
+
+#include <stddef.h>
+
+/*
+ * Batch consumer of PSA-eBPF digests, for digest maps pinned by the pipeline
+ * (e.g. /sys/fs/bpf/pipeline99/maps/digest_0).
+ *
+ * BPF_MAP_TYPE_RINGBUF digests are drained in batches: digest_consumer__poll() waits on
+ * the epoll fd of the ring buffer until the data path signals pending digests or the
+ * timeout expires, then consumes everything written so far. BPF_MAP_TYPE_QUEUE digests
+ * are popped one per syscall until the queue is empty; an empty queue is polled again every
+ * 50 us until the timeout, as it has no wakeup.
+ */
+
+/*
+ * called for every digest; a negative return value stops the current batch and is returned
+ * by digest_consumer__poll() (like ring_buffer__consume(), which ignores positive values)
+ */
+typedef int (*digest_cb)(void *ctx, const void *msg, size_t size);
+
+struct digest_consumer;
+
+struct digest_consumer *digest_consumer__open(const char *pin_path, digest_cb cb, void *ctx);
+/* epoll fd to wait on (ring buffer only), -1 for a queue */
+int digest_consumer__epoll_fd(const struct digest_consumer *c);
+/* drain pending digests, waiting up to timeout_ms for them; returns the number of digests or -errno */
+int digest_consumer__poll(struct digest_consumer *c, int timeout_ms);
+void digest_consumer__free(struct digest_consumer *c);
+
+#endif  /* DIGEST_CONSUMER_H */
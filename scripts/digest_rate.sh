@@ -0,0 +1,59 @@
+#!/bin/bash
+#
+# Data path cost and drain rate of PSA-eBPF digests.
+#
+# Usage: sudo -E ./scripts/digest_rate.sh -E <ENV-FILE> -C <CORES> [-d DURATION] [-o RESULTS] \
+#            [-c COMMANDS] [-t TIMEOUT_MS] NAME:PROGRAM[:CFLAGS] [NAME:PROGRAM[:CFLAGS]...]
+#
+# Each variant is deployed by setup_test.sh with PROGRAM, the COMMANDS runtime file
+# (default runtime_cmd/03_psa_externs/base_forwarding.txt) and CFLAGS passed with --cflags.
+# While the generator sends traffic, cycles per packet of xdp_ingress_fun are counted with
+# scripts/prog_profile.sh and, at the same time, scripts/digest_consumer.c drains the digest
+# map (pipeline 99, digest_0) for DURATION seconds. RESULTS gets one line per variant:
+# <name> <cycles/pkt> <packets> <digests drained> <digests/s> <digests lost (approximate)>
+# Digests lost are packets not matched by a drained digest (overwritten in a full queue or
+# dropped by a full ring buffer). The figure is approximate: packets are counted by the
+# profiler and digests by the consumer, whose windows of DURATION seconds start at slightly
+# different times, and the consumer also drains digests queued before its window.
+
+DURATION=30
+RESULTS=digest_rate.txt
+COMMANDS=runtime_cmd/03_psa_externs/base_forwarding.txt
+TIMEOUT_MS=100
+
+POSITIONAL=()
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -E) ENV_FILE="$2"; shift; shift ;;
+    -C) CORES="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -c) COMMANDS="$2"; shift; shift ;;
+    -t) TIMEOUT_MS="$2"; shift; shift ;;
+    *) POSITIONAL+=("$1"); shift ;;
+  esac
+done
+
+if [[ -z "$ENV_FILE" || -z "$CORES" || ${#POSITIONAL[@]} -eq 0 ]]; then
+  echo "Usage: $0 -E <ENV-FILE> -C <CORES> [-d DURATION] [-o RESULTS] [-c COMMANDS] [-t TIMEOUT_MS] NAME:PROGRAM[:CFLAGS]..."
+  exit 1
+fi
+
+clang scripts/digest_consumer.c -o digest_consumer -lbpf || exit 1
+
+echo "# name cycles_per_packet packets digests digests_per_second digests_lost_approx" > "$RESULTS"
+for arg in "${POSITIONAL[@]}"; do
+  IFS=':' read -r name program cflags <<< "$arg"
+  ./setup_test.sh -C "$CORES" --target psa-ebpf -E "$ENV_FILE" -c "$COMMANDS" \
+      ${cflags:+--cflags "$cflags"} "$program" > /dev/null
+  read -p "[$name] Start traffic on the generator and press Enter.."
+  ./digest_consumer -d "$DURATION" -t "$TIMEOUT_MS" /sys/fs/bpf/pipeline99/maps/digest_0 > digest_consumer.out &
+  PROFILE="$(bash scripts/prog_profile.sh "$DURATION" xdp_ingress_fun)"
+  wait
+  read -r digests seconds rate < digest_consumer.out
+  packets="$(echo "$PROFILE" | awk '{print $2}')"
+  cycles="$(echo "$PROFILE" | awk '{print $4}')"
+  lost=$(( ${packets:-0} > ${digests:-0} ? ${packets:-0} - ${digests:-0} : 0 ))
+  echo "$name ${cycles:-0} ${packets:-0} ${digests:-0} ${rate:-0} $lost" | tee -a "$RESULTS"
+done
+rm -f digest_consumer digest_consumer.out
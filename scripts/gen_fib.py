@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+#
+# Generate a synthetic IPv4 FIB with a BGP-like prefix length distribution.
+#
+# Usage:
+#   python3 scripts/gen_fib.py [--seed 1] [--port PORT] [--ports N] NUM_PREFIXES > fib.txt
+#
+# Every output line is "<prefix>/<length> <egress port>", the key and data format of
+# 'psabpf-ctl table add ... key <prefix>/<length> data <port>'.
+# Prefixes longer than /16 are clustered in a limited set of /16 blocks, as more-specifics
+# are in real routing tables. Egress ports are PORT, PORT+1, ..., PORT+N-1 (round robin).
+
+import argparse
+import random
+import sys
+
+# share of prefixes per length, roughly as in a public IPv4 BGP table
+LENGTH_DISTRIBUTION = {
+    8: 0.0001, 9: 0.0001, 10: 0.0003, 11: 0.0008, 12: 0.0015, 13: 0.003, 14: 0.005,
+    15: 0.008, 16: 0.013, 17: 0.008, 18: 0.014, 19: 0.025, 20: 0.042, 21: 0.05,
+    22: 0.105, 23: 0.09, 24: 0.62, 25: 0.002, 26: 0.002, 27: 0.0015, 28: 0.001,
+    29: 0.001, 30: 0.001, 31: 0.0003, 32: 0.0007,
+}
+
+# share of /16 blocks that carry more-specific prefixes, relative to the FIB size
+BLOCKS_PER_PREFIX = 1.0 / 8
+
+
+def random_block(rng):
+    # unicast space 1.0.0.0 - 223.255.255.255, without 10/8 and 127/8
+    while True:
+        first = rng.randint(1, 223)
+        if first not in (10, 127):
+            return (first << 8) | rng.randint(0, 255)
+
+
+def generate(num_prefixes, rng):
+    lengths = sorted(LENGTH_DISTRIBUTION)
+    weights = [LENGTH_DISTRIBUTION[l] for l in lengths]
+    blocks = [random_block(rng) for _ in range(max(1, int(num_prefixes * BLOCKS_PER_PREFIX)))]
+    prefixes = set()
+    while len(prefixes) < num_prefixes:
+        length = rng.choices(lengths, weights)[0]
+        if length > 16:
+            addr = (rng.choice(blocks) << 16) | rng.getrandbits(16)
+        else:
+            addr = random_block(rng) << 16
+        addr &= (0xffffffff << (32 - length)) & 0xffffffff
+        prefixes.add((addr, length))
+    return prefixes
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BGP-like FIB generator")
+    parser.add_argument("--seed", type=int, default=1, help="random seed (default 1)")
+    parser.add_argument("--port", default="1", help="first egress port (default 1)")
+    parser.add_argument("--ports", type=int, default=1, help="number of egress ports (default 1)")
+    parser.add_argument("num_prefixes", type=int, help="number of prefixes")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    port = int(args.port, 0)
+    for i, (addr, length) in enumerate(sorted(generate(args.num_prefixes, rng))):
+        print("{}.{}.{}.{}/{} {}".format(addr >> 24, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff,
+                                         length, port + i % args.ports))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+#
+# Generate entries for the tbl_fwd table of p4testdata/04_tables/{exact,lpm,ternary}.p4.
+#
+# Usage:
+#   python3 scripts/gen_table.py [--seed 1] [--port PORT] [--addresses FILE] {exact,lpm,ternary} NUM_ENTRIES
+#
+# Every output line is "<key> <egress port> [priority]", i.e. the key, data and priority
+# arguments of 'psabpf-ctl table add pipe 99 ingress_tbl_fwd id 1 key <key> data <port> [priority <p>]':
+# - exact:   random unicast host addresses,
+# - lpm:     a BGP-like FIB (see scripts/gen_fib.py),
+# - ternary: an ACL-like rule set, destination prefixes with /8../32 masks and unique priorities.
+# With --addresses, destination addresses that hit the generated entries are written to FILE
+# (one per line), to be used as test traffic.
+
+import argparse
+import random
+import sys
+
+import gen_fib
+
+# ACL rules are dominated by host and /24 rules
+ACL_MASK_DISTRIBUTION = {8: 0.02, 16: 0.08, 20: 0.05, 22: 0.05, 24: 0.4, 28: 0.1, 32: 0.3}
+
+
+def ip(addr):
+    return "{}.{}.{}.{}".format(addr >> 24, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff)
+
+
+def mask(length):
+    return (0xffffffff << (32 - length)) & 0xffffffff
+
+
+def exact(num_entries, rng):
+    addrs = set()
+    while len(addrs) < num_entries:
+        addrs.add((gen_fib.random_block(rng) << 16) | rng.getrandbits(16))
+    return [(ip(a), a, None) for a in sorted(addrs)]
+
+
+def lpm(num_entries, rng):
+    return [("{}/{}".format(ip(a), l), a | (rng.getrandbits(32) & ~mask(l) & 0xffffffff), None)
+            for a, l in sorted(gen_fib.generate(num_entries, rng))]
+
+
+def ternary(num_entries, rng):
+    lengths = sorted(ACL_MASK_DISTRIBUTION)
+    weights = [ACL_MASK_DISTRIBUTION[l] for l in lengths]
+    rules = set()
+    while len(rules) < num_entries:
+        length = rng.choices(lengths, weights)[0]
+        rules.add(((gen_fib.random_block(rng) << 16 | rng.getrandbits(16)) & mask(length), length))
+    # more specific rules get higher priority
+    return [("{}^0x{:08x}".format(ip(a), mask(l)), a | (rng.getrandbits(32) & ~mask(l) & 0xffffffff), prio)
+            for prio, (a, l) in enumerate(sorted(rules, key=lambda r: r[1]), start=1)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Table entries generator for 04_tables programs")
+    parser.add_argument("--seed", type=int, default=1, help="random seed (default 1)")
+    parser.add_argument("--port", default="1", help="egress port (default 1)")
+    parser.add_argument("--addresses", help="write matching destination addresses to this file")
+    parser.add_argument("kind", choices=["exact", "lpm", "ternary"], help="table match kind")
+    parser.add_argument("num_entries", type=int, help="number of entries")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    entries = {"exact": exact, "lpm": lpm, "ternary": ternary}[args.kind](args.num_entries, rng)
+    for key, _, prio in entries:
+        print("{} {}{}".format(key, args.port, "" if prio is None else " {}".format(prio)))
+    if args.addresses:
+        with open(args.addresses, "w") as f:
+            for _, addr, _ in entries:
+                f.write(ip(addr) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,42 @@
+#!/bin/bash
+#
+# Cycles saved by the lazy header reset (p4testdata/01_use_cases/cycles/*/lazy-reset) per use case.
+#
+# Usage: sudo -E ./scripts/hdr_reset_cycles.sh [-d DURATION] [-o RESULTS] [-s STAGE]
+#
+# For L2L3-ACL, BNG and UPF, the STAGE (ig-parser by default, or ig-control) program of the
+# xdp/ variant (hdr_md memset) and of the lazy-reset/ variant are measured with
+# scripts/prog_cycles.sh. RESULTS gets one line per use case:
+# <use case> <cycles/pkt memset> <cycles/pkt lazy reset> <cycles/pkt saved>
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+DURATION=10
+RESULTS=hdr_reset_cycles.txt
+STAGE=ig-parser
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -s) STAGE="$2"; shift; shift ;;
+    *) echo "Unknown option $1"; exit 1 ;;
+  esac
+done
+
+CYCLES=p4testdata/01_use_cases/cycles
+PROGRAMS=()
+for uc in l2l3-acl:l2l3 bng:bng upf:upf; do
+  IFS=: read -r DIR PREFIX <<< "$uc"
+  PROGRAMS+=("$DIR-memset:$CYCLES/$DIR/xdp/$PREFIX-$STAGE.c" "$DIR-lazy:$CYCLES/$DIR/lazy-reset/$PREFIX-$STAGE.c")
+done
+
+WORKDIR=$(mktemp -d)
+bash scripts/prog_cycles.sh -d "$DURATION" -o "$WORKDIR/cycles" "${PROGRAMS[@]}" || exit 1
+
+echo "# use_case memset_cycles_per_packet lazy_cycles_per_packet saved_cycles_per_packet" > "$RESULTS"
+awk '!/^#/ {uc = $1; variant = $1; sub(/-[a-z]+$/, "", uc); sub(/.*-/, "", variant); c[uc, variant] = $4; ucs[uc] = 1}
+     END {for (uc in ucs) printf "%s %.2f %.2f %.2f\n", uc, c[uc, "memset"], c[uc, "lazy"], c[uc, "memset"] - c[uc, "lazy"]}' \
+  "$WORKDIR/cycles" | \
+  sort | tee -a "$RESULTS"
+rm -rf "$WORKDIR"
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+#
+# Traffic generator of the single machine testbed (setup_test.sh --loopback).
+#
+# Usage:
+#   sudo python3 scripts/loopback_gen.py throughput --profile PROFILE [--size 64] [--duration 10]
+#   sudo python3 scripts/loopback_gen.py latency --profile PROFILE [--size 64] [--duration 10] [--rate 1000]
+#   python3 scripts/loopback_gen.py pcap --profile PROFILE [--size 64] [--dst-mac MAC] OUTPUT
+#
+# Frames of PROFILE (the packets of the TRex profiles in trex_scripts/, see PROFILES) are sent
+# from gen0 in network namespace psa_gen0 to the DUT port psa_lb0 and received by gen1 in
+# psa_gen1, the peer of the DUT port psa_lb1. Destination MAC is the MAC of gen1
+# (GENERATOR_MAC1), as sent by TRex, unless the profile says otherwise.
+# throughput: frames are replayed as fast as possible (tcpreplay --topspeed if installed,
+#   otherwise from an AF_PACKET socket), prints: <sent pps> <received pps> <loss %>
+# latency: RATE frames per second carry a sequence number and a send timestamp; the one-way
+#   latency is exact as both ends share the clock of the machine. Prints:
+#   <sent> <received> <min us> <avg us> <p50 us> <p99 us> <p99.9 us> <max us>
+# pcap: writes the frame of PROFILE to OUTPUT (e.g. for scripts/test_run_bench.sh -f).
+
+import argparse
+import ctypes
+import ipaddress
+import json
+import os
+import shutil
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+from test_packets import checksum
+
+GEN_NS = ("psa_gen0", "psa_gen1")
+GEN_INTF = ("gen0", "gen1")
+LATENCY_MARKER = b"PSALAT"
+LATENCY_TAG = struct.Struct("!6sIQ")
+CLONE_NEWNET = 0x40000000
+ETH_P_ALL = 0x0003
+
+
+def ipv4_udp(src, dst, sport, dport, payload):
+    udp = struct.pack("!HHHH", sport, dport, 8 + len(payload), 0) + payload
+    ip = struct.pack("!BBHHHBBH4s4s", 0x45, 0, 20 + len(udp), 0xffff, 0, 64, 17, 0,
+                     ipaddress.IPv4Address(src).packed, ipaddress.IPv4Address(dst).packed)
+    return ip[:10] + struct.pack("!H", checksum(ip)) + ip[12:] + udp
+
+
+def mac(addr):
+    return bytes.fromhex(addr.replace(":", ""))
+
+
+def udp_1flow(payload, gen1_mac):
+    return 0x0800, ipv4_udp("16.0.0.1", "48.0.0.1", 1025, 12, payload)
+
+
+def upf_ul(payload, gen1_mac):
+    inner = ipv4_udp("10.10.10.10", "192.168.2.21", 99, 99, payload)
+    gtp = struct.pack("!BBHI", 0x30, 0xff, len(inner), 1234) + inner
+    return 0x0800, ipv4_udp("172.20.16.99", "172.20.16.105", 2152, 2152, gtp)
+
+
+def upf_dl(payload, gen1_mac):
+    return 0x0800, ipv4_udp("16.0.0.4", "48.0.0.4", 1025, 12, payload)
+
+
+def bng_ul(payload, gen1_mac):
+    inner = ipv4_udp("10.10.10.10", "192.168.2.21", 99, 99, payload)
+    ppp = struct.pack("!BBHHH", 0x11, 0, 100, len(inner) + 2, 0x0021) + inner
+    return 0x8100, struct.pack("!HHHH", 10, 0x8100, 100, 0x8864) + ppp
+
+
+def vxlan_decap(payload, gen1_mac):
+    inner = mac(gen1_mac) + bytes.fromhex("00aabbccddee") + struct.pack("!H", 0x0800) + \
+        ipv4_udp("16.0.0.1", "48.0.0.1", 1025, 12, payload)
+    vxlan = struct.pack("!II", 0x08000000, 200 << 8) + inner
+    return 0x0800, ipv4_udp("172.168.1.200", "172.168.1.100", 1025, 4789, vxlan)
+
+
+# name: (L3 builder, destination MAC or None for GENERATOR_MAC1, setup_test.sh scenarios)
+PROFILES = {
+    "udp": (udp_1flow, None, "l2fwd, bng downlink, vxlan encap"),
+    "l2l3": (udp_1flow, "00:00:00:00:00:01", "l2l3-acl (routing)"),
+    "upf_ul": (upf_ul, None, "upf uplink"),
+    "upf_dl": (upf_dl, None, "upf downlink"),
+    "bng_ul": (bng_ul, None, "bng uplink"),
+    "vxlan_decap": (vxlan_decap, None, "vxlan decap"),
+}
+
+
+def build_frame(profile, size, src_mac, gen1_mac, payload=b""):
+    builder, dst, _ = PROFILES[profile]
+    ether = mac(dst or gen1_mac) + mac(src_mac)
+    # 4 B of FCS are not part of the frame, like in trex_scripts/
+    headers = 14 + len(builder(b"", gen1_mac)[1])
+    ether_type, l3 = builder(payload + bytes(max(0, size - 4 - headers - len(payload))), gen1_mac)
+    return ether + struct.pack("!H", ether_type) + l3
+
+
+def link_address(ns, intf):
+    out = subprocess.run(["ip", "-n", ns, "-j", "link", "show", intf], check=True,
+                         capture_output=True, text=True).stdout
+    return json.loads(out)[0]["address"]
+
+
+def link_stat(ns, intf, stat):
+    out = subprocess.run(["ip", "netns", "exec", ns, "cat", "/sys/class/net/{}/statistics/{}".format(intf, stat)],
+                         check=True, capture_output=True, text=True).stdout
+    return int(out)
+
+
+def netns_socket(ns, intf):
+    """AF_PACKET socket bound to intf of network namespace ns."""
+    libc = ctypes.CDLL(None, use_errno=True)
+    own = os.open("/proc/self/ns/net", os.O_RDONLY)
+    target = os.open("/var/run/netns/" + ns, os.O_RDONLY)
+    try:
+        if libc.setns(target, CLONE_NEWNET) != 0:
+            raise OSError(ctypes.get_errno(), "setns({})".format(ns))
+        sock = socket.socket(socket.AF_PACKET, socket.SOCK_RAW, socket.htons(ETH_P_ALL))
+        sock.bind((intf, 0))
+    finally:
+        libc.setns(own, CLONE_NEWNET)
+        os.close(own)
+        os.close(target)
+    return sock
+
+
+def write_pcap(path, frames):
+    with open(path, "wb") as f:
+        f.write(struct.pack("=IHHiIII", 0xa1b2c3d4, 2, 4, 0, 0, 65535, 1))
+        for frame in frames:
+            f.write(struct.pack("=IIII", 0, 0, len(frame), len(frame)) + frame)
+
+
+def throughput(frame, duration):
+    tx0 = link_stat(GEN_NS[0], GEN_INTF[0], "tx_packets")
+    rx0 = link_stat(GEN_NS[1], GEN_INTF[1], "rx_packets")
+    start = time.monotonic()
+    if shutil.which("tcpreplay"):
+        with tempfile.NamedTemporaryFile(suffix=".pcap") as pcap:
+            write_pcap(pcap.name, [frame])
+            subprocess.run(["timeout", str(duration), "ip", "netns", "exec", GEN_NS[0], "tcpreplay", "-q",
+                            "--topspeed", "--loop=0", "--preload-pcap", "-i", GEN_INTF[0], pcap.name],
+                           stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    else:
+        sock = netns_socket(GEN_NS[0], GEN_INTF[0])
+        end = start + duration
+        while time.monotonic() < end:
+            for _ in range(1000):
+                try:
+                    sock.send(frame)
+                except OSError:
+                    pass
+        sock.close()
+    elapsed = time.monotonic() - start
+    # let the last frames arrive
+    time.sleep(0.5)
+    sent = link_stat(GEN_NS[0], GEN_INTF[0], "tx_packets") - tx0
+    received = link_stat(GEN_NS[1], GEN_INTF[1], "rx_packets") - rx0
+    loss = 100 * (sent - received) / sent if sent else 0
+    print("{:.0f} {:.0f} {:.2f}".format(sent / elapsed, received / elapsed, max(loss, 0)))
+
+
+def latency(profile, size, src_mac, gen1_mac, duration, rate):
+    rx = netns_socket(GEN_NS[1], GEN_INTF[1])
+    rx.settimeout(0.2)
+    tx = netns_socket(GEN_NS[0], GEN_INTF[0])
+    samples = []
+    stop = threading.Event()
+
+    def receive():
+        while not stop.is_set():
+            try:
+                data = rx.recv(65535)
+            except socket.timeout:
+                continue
+            now = time.monotonic_ns()
+            pos = data.find(LATENCY_MARKER)
+            if pos >= 0 and pos + LATENCY_TAG.size <= len(data):
+                _, _, sent_ns = LATENCY_TAG.unpack_from(data, pos)
+                samples.append(now - sent_ns)
+
+    receiver = threading.Thread(target=receive)
+    receiver.start()
+    period = 1.0 / rate
+    sent = 0
+    next_send = time.monotonic()
+    end = next_send + duration
+    while next_send < end:
+        tag = LATENCY_TAG.pack(LATENCY_MARKER, sent, time.monotonic_ns())
+        tx.send(build_frame(profile, size, src_mac, gen1_mac, tag))
+        sent += 1
+        next_send += period
+        delay = next_send - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+    time.sleep(0.5)
+    stop.set()
+    receiver.join()
+    tx.close()
+    rx.close()
+
+    if not samples:
+        print(sent, 0, 0, 0, 0, 0, 0, 0)
+        return
+    samples.sort()
+    us = [s / 1000 for s in samples]
+
+    def pct(p):
+        return us[min(len(us) - 1, int(p / 100 * len(us)))]
+    print(sent, len(us), *("{:.2f}".format(v) for v in
+                           (us[0], sum(us) / len(us), pct(50), pct(99), pct(99.9), us[-1])))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Traffic generator of the loopback testbed")
+    parser.add_argument("mode", choices=["throughput", "latency", "pcap"])
+    parser.add_argument("--profile", choices=sorted(PROFILES), default="udp",
+                        help="; ".join("{}: {}".format(n, p[2]) for n, p in sorted(PROFILES.items())))
+    parser.add_argument("--size", type=int, default=64, help="frame size with FCS (default 64)")
+    parser.add_argument("--duration", type=float, default=10, help="seconds (default 10)")
+    parser.add_argument("--rate", type=int, default=1000, help="latency probes per second (default 1000)")
+    parser.add_argument("--src-mac", help="source MAC (default: MAC of gen0)")
+    parser.add_argument("--dst-mac", help="GENERATOR_MAC1 (default: MAC of gen1)")
+    parser.add_argument("output", nargs="?", help="pcap file (pcap mode)")
+    args = parser.parse_intermixed_args()
+
+    src_mac = args.src_mac or (link_address(GEN_NS[0], GEN_INTF[0]) if args.mode != "pcap" else "00:aa:bb:cc:dd:ee")
+    gen1_mac = args.dst_mac or (link_address(GEN_NS[1], GEN_INTF[1]) if args.mode != "pcap" else "00:11:22:33:44:55")
+
+    if args.mode == "pcap":
+        if not args.output:
+            sys.exit("OUTPUT is required in pcap mode")
+        write_pcap(args.output, [build_frame(args.profile, args.size, src_mac, gen1_mac)])
+    elif args.mode == "throughput":
+        throughput(build_frame(args.profile, args.size, src_mac, gen1_mac), args.duration)
+    else:
+        latency(args.profile, args.size, src_mac, gen1_mac, args.duration, args.rate)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+# Install entries of the LPM table ingress_tbl_fwd into the multibit trie
+# (see p4testdata/04_tables/multibit/lpm-control.c).
+#
+# Usage:
+#   sudo python3 scripts/lpm_multibit.py [--pipe 99] [--verify N] [--dry-run] [RULES-FILE]
+#
+# Every line of RULES-FILE (or stdin) is one entry in the format used by psabpf-ctl:
+#   <PREFIX>/<LENGTH> <EGRESS-PORT>
+# e.g. "48.1.0.0/16 5" (scripts/gen_fib.py generates such files).
+# The trie is rebuilt from all entries and written directly to the memory of the
+# (BPF_F_MMAPABLE) array maps. Chunks and next hops of the trie being replaced are left
+# untouched: the new ones go to slots that the live trie does not reference (next hops with
+# the same value are shared), first next hops, then levels 3 and 2, and the level 1 entries
+# are switched last, each with one 8-byte store. A lookup reads one level 1 entry, so it walks
+# either the old or the new trie, and a reload can run with traffic. The maps must have room
+# for both tries; slots of the old trie are reused by the next reload.
+#
+# --verify N  compares the built trie with a reference longest prefix match for
+#             N random addresses and the first/last address of every prefix
+# --dry-run   builds (and verifies) the trie without writing maps
+
+import argparse
+import array
+import ipaddress
+import mmap
+import os
+import random
+import sys
+import time
+
+import bpfsys
+
+POINTER = 0x80000000
+# array maps store values with 8 bytes stride
+ELEM_SIZE = 8
+ACT_DO_FORWARD = 1
+
+
+class Trie:
+    def __init__(self):
+        self.nexthops = [None]  # index 0 is a miss
+        self.nexthop_ids = {}
+        self.l1 = [0] * 65536
+        self.l2 = []
+        self.l3 = []
+
+    def nexthop(self, port):
+        if port not in self.nexthop_ids:
+            self.nexthop_ids[port] = len(self.nexthops)
+            self.nexthops.append(port)
+        return self.nexthop_ids[port]
+
+    @staticmethod
+    def chunk(parent, idx, level):
+        if not parent[idx] & POINTER:
+            level.append([parent[idx]] * 256)
+            parent[idx] = POINTER | (len(level) - 1)
+        return level[parent[idx] & ~POINTER]
+
+    def add(self, addr, length, port):
+        nh = self.nexthop(port)
+        if length <= 16:
+            start = addr >> 16
+            count = 1 << (16 - length)
+            self.l1[start:start + count] = [nh] * count
+        elif length <= 24:
+            l2 = self.chunk(self.l1, addr >> 16, self.l2)
+            start = (addr >> 8) & 0xff
+            count = 1 << (24 - length)
+            l2[start:start + count] = [nh] * count
+        else:
+            l2 = self.chunk(self.l1, addr >> 16, self.l2)
+            l3 = self.chunk(l2, (addr >> 8) & 0xff, self.l3)
+            start = addr & 0xff
+            count = 1 << (32 - length)
+            l3[start:start + count] = [nh] * count
+
+    def lookup(self, addr):
+        e = self.l1[addr >> 16]
+        if e & POINTER:
+            e = self.l2[e & ~POINTER][(addr >> 8) & 0xff]
+            if e & POINTER:
+                e = self.l3[e & ~POINTER][addr & 0xff]
+        return self.nexthops[e]
+
+
+def parse_rules(lines):
+    rules = []
+    for line in lines:
+        line = line.split("#")[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        prefix = ipaddress.IPv4Network(fields[0], strict=False)
+        rules.append((int(prefix.network_address), prefix.prefixlen, int(fields[1], 0)))
+    return rules
+
+
+def build(rules):
+    trie = Trie()
+    # shorter prefixes first, so that more specific ones overwrite them
+    for addr, length, port in sorted(rules, key=lambda r: r[1]):
+        trie.add(addr, length, port)
+    return trie
+
+
+def verify(trie, rules, samples, rng):
+    by_length = {}
+    for addr, length, port in rules:
+        by_length.setdefault(length, {})[addr] = port
+    lengths = sorted(by_length, reverse=True)
+
+    def reference(a):
+        for length in lengths:
+            port = by_length[length].get(a & ((0xffffffff << (32 - length)) & 0xffffffff))
+            if port is not None:
+                return port
+        return None
+
+    addrs = [rng.getrandbits(32) for _ in range(samples)]
+    for addr, length, _ in rules:
+        addrs += [addr, addr | ((1 << (32 - length)) - 1)]
+    errors = sum(1 for a in addrs if trie.lookup(a) != reference(a))
+    print("Verified {} addresses, {} mismatches".format(len(addrs), errors))
+    return errors == 0
+
+
+def map_array(path):
+    """Memory of an array map as a sequence of 8-byte elements."""
+    fd = bpfsys.obj_get(path)
+    try:
+        max_entries = bpfsys.map_info(fd).max_entries
+        size = mmap.PAGESIZE * ((max_entries * ELEM_SIZE + mmap.PAGESIZE - 1) // mmap.PAGESIZE)
+        mem = mmap.mmap(fd, size, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE)
+    finally:
+        os.close(fd)
+    return memoryview(mem).cast("Q")[:max_entries]
+
+
+def free_slots(used, count, first=0):
+    return (i for i in range(first, count) if i not in used)
+
+
+def install(trie, l1, l2, l3, nexthops):
+    """Write the trie next to the live one and switch the level 1 entries to it."""
+    # slots referenced by the live trie
+    live_l2 = {e & ~POINTER for e in l1.tolist() if e & POINTER}
+    live_l3, live_nh = set(), {e for e in l1.tolist() if e and not e & POINTER}
+    for c in live_l2:
+        for e in l2[c * 256:(c + 1) * 256].tolist():
+            if e & POINTER:
+                live_l3.add(e & ~POINTER)
+            elif e:
+                live_nh.add(e)
+    for c in live_l3:
+        live_nh.update(e for e in l3[c * 256:(c + 1) * 256].tolist() if e)
+
+    # struct ingress_tbl_fwd_value { unsigned int action; u32 egress_port; }
+    shared = {nexthops[i]: i for i in live_nh}
+    slots = free_slots(live_nh, len(nexthops), 1)
+    nh_map = [0]
+    for port in trie.nexthops[1:]:
+        value = ACT_DO_FORWARD | (port << 32)
+        if value not in shared:
+            slot = next(slots, None)
+            if slot is None:
+                raise ValueError("no free next hop")
+            nexthops[slot] = value
+            shared[value] = slot
+        nh_map.append(shared[value])
+
+    def place(chunks, live, level_map, level):
+        slots = [slot for slot, _ in zip(free_slots(live, len(level_map) // 256), chunks)]
+        if len(slots) < len(chunks):
+            raise ValueError("{} level {} chunks needed, {} free".format(len(chunks), level, len(slots)))
+        return slots
+
+    l3_map = place(trie.l3, live_l3, l3, 3)
+    l2_map = place(trie.l2, live_l2, l2, 2)
+
+    def relocate(entries, chunk_map):
+        return array.array("Q", [POINTER | chunk_map[e & ~POINTER] if e & POINTER else nh_map[e] for e in entries])
+
+    for slot, chunk in zip(l3_map, trie.l3):
+        l3[slot * 256:(slot + 1) * 256] = relocate(chunk, None)
+    for slot, chunk in zip(l2_map, trie.l2):
+        l2[slot * 256:(slot + 1) * 256] = relocate(chunk, l3_map)
+    # one store per entry, never a torn or half copied entry
+    for i, e in enumerate(relocate(trie.l1, l2_map)):
+        if l1[i] != e:
+            l1[i] = e
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Multibit trie loader for ingress_tbl_fwd")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--verify", type=int, metavar="N", help="verify the trie with N random addresses")
+    parser.add_argument("--dry-run", action="store_true", help="do not write maps")
+    parser.add_argument("rules", nargs="?", help="file with entries (default: stdin)")
+    args = parser.parse_args()
+
+    with open(args.rules) if args.rules else sys.stdin as f:
+        rules = parse_rules(f)
+
+    start = time.time()
+    trie = build(rules)
+    print("Built trie for {} prefixes in {:.2f} s: {} next hops, {} level 2 chunks, {} level 3 chunks".format(
+        len(rules), time.time() - start, len(trie.nexthops) - 1, len(trie.l2), len(trie.l3)))
+    if args.verify is not None and not verify(trie, rules, args.verify, random.Random(1)):
+        return 1
+    if args.dry_run:
+        return 0
+
+    start = time.time()
+    maps_dir = "/sys/fs/bpf/pipeline{}/maps".format(args.pipe)
+    try:
+        install(trie, *(map_array(os.path.join(maps_dir, "ingress_tbl_fwd_mbt_" + name))
+                        for name in ("l1", "l2", "l3", "nexthops")))
+    except (OSError, ValueError) as e:
+        print("Cannot write trie ({}); if the old and the new trie do not fit, rebuild the program with larger "
+              "-DINGRESS_TBL_FWD_MBT_L2_CHUNKS/-DINGRESS_TBL_FWD_MBT_L3_CHUNKS".format(e), file=sys.stderr)
+        return 1
+    print("Installed {} prefixes in {:.2f} s".format(len(rules), time.time() - start))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#
+# Mirror PSA multicast groups into the per-group devmaps of the XDP multicast
+# (multicast_grp_devmap, see p4testdata/01_use_cases/cycles/l2l3-acl/xdp-multicast).
+#
+# Usage:
+#   sudo python3 scripts/mcast_devmap.py [--pipe 99] [GROUP...]
+#
+# Members of every GROUP (default: all groups) are read from multicast_grp_tbl, as written by
+# 'psabpf-ctl multicast-group', into a new DEVMAP_HASH keyed by egress port. Each port is given
+# the egress program of its tx_port entry, so that bpf_redirect_map() with BPF_F_BROADCAST runs
+# the XDP egress once per replica. The new devmap replaces the previous one of the group with a
+# single map update; groups without members are removed.
+# A devmap holds one replica per port, members differing only in the instance are merged.
+# Run it again after every change of the multicast groups.
+
+import argparse
+import os
+import struct
+import sys
+
+import bpfsys
+
+# elem_t (struct list_key_t): port, instance
+ELEM_KEY = struct.Struct("=IH2x")
+# struct bpf_devmap_val: ifindex, program fd (id when read back)
+DEVMAP_VAL = struct.Struct("=Ii")
+DEVMAP_SIZE = 256
+
+
+def group_ports(outer_fd, group):
+    inner_id = bpfsys.map_lookup(outer_fd, struct.pack("=I", group), 4)
+    if inner_id is None:
+        return []
+    inner_fd = bpfsys.map_fd_by_id(struct.unpack("=I", inner_id)[0])
+    try:
+        ports = {ELEM_KEY.unpack(key)[0] for key in bpfsys.map_keys(inner_fd, ELEM_KEY.size)}
+    finally:
+        os.close(inner_fd)
+    # the list head has key {0, 0}
+    ports.discard(0)
+    return sorted(ports)
+
+
+def egress_prog_fd(tx_port_fd, port):
+    value = bpfsys.map_lookup(tx_port_fd, struct.pack("=I", port % DEVMAP_SIZE), DEVMAP_VAL.size)
+    if value is None:
+        return -1
+    ifindex, prog_id = DEVMAP_VAL.unpack(value)
+    if ifindex != port or prog_id <= 0:
+        return -1
+    return bpfsys.prog_fd_by_id(prog_id)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Mirror PSA multicast groups into XDP devmaps")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("groups", nargs="*", type=int, help="multicast groups (default: all)")
+    args = parser.parse_args()
+
+    maps_dir = "/sys/fs/bpf/pipeline{}/maps".format(args.pipe)
+    groups_fd = bpfsys.obj_get(os.path.join(maps_dir, "multicast_grp_tbl"))
+    devmaps_fd = bpfsys.obj_get(os.path.join(maps_dir, "multicast_grp_devmap"))
+    tx_port_fd = bpfsys.obj_get(os.path.join(maps_dir, "tx_port"))
+    groups = args.groups or range(1, bpfsys.map_info(groups_fd).max_entries)
+
+    for group in groups:
+        ports = group_ports(groups_fd, group)
+        if not ports:
+            try:
+                bpfsys.map_delete(devmaps_fd, struct.pack("=I", group))
+            except FileNotFoundError:
+                pass
+            if args.groups:
+                print("group {}: no members".format(group))
+            continue
+        devmap_fd = bpfsys.map_create(bpfsys.BPF_MAP_TYPE_DEVMAP_HASH, 4, DEVMAP_VAL.size, DEVMAP_SIZE,
+                                      name="mcast_grp_{}".format(group).encode())
+        try:
+            for port in ports:
+                prog_fd = egress_prog_fd(tx_port_fd, port)
+                try:
+                    bpfsys.map_update(devmap_fd, struct.pack("=I", port), DEVMAP_VAL.pack(port, prog_fd))
+                finally:
+                    if prog_fd >= 0:
+                        os.close(prog_fd)
+            bpfsys.map_update(devmaps_fd, struct.pack("=I", group), struct.pack("=I", devmap_fd))
+        finally:
+            os.close(devmap_fd)
+        print("group {}: ports {}".format(group, " ".join(str(p) for p in ports)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+#
+# Cycles per packet of every program of a loaded PSA-eBPF pipeline, measured while traffic runs.
+# Automates "Measuring total CPU cycles" of the README.
+#
+# Usage:
+#   sudo python3 scripts/pipeline_cycles.py [--pipe 99] [--duration 30] [--cpus LIST]
+#       [--baseline-duration 5 | --no-baseline] [--output FILE]
+#
+# The programs are the ones pinned by 'psabpf-ctl pipeline load' in /sys/fs/bpf/pipeline<ID>
+# (xdp_func, tc_ingress_func, tc_egress_func or xdp_ingress_func, xdp_egress_func) and the ones
+# using its maps. All of them are profiled at the same time for --duration seconds with
+# 'bpftool prog profile' (cycles, instructions, LLC misses); start the traffic first.
+# Tail call targets (programs in a BPF_MAP_TYPE_PROG_ARRAY of the pipeline) cannot be profiled:
+# a tail call does not enter the fentry/fexit trampolines, so their run count stays 0. Their
+# cycles are part of the program that tail-calls them, they are listed under "tail_calls".
+# 'bpftool prog profile' does not scale its counts when the PMU counters are multiplexed; the
+# counts are scaled here by the percentage it prints and the lowest one is reported as
+# "counter_running_percent".
+# In a second window of --duration seconds, 'perf stat' counts cycles, instructions, cache misses
+# and branch misses of the --cpus (default: all CPUs), i.e. of the whole data path including the
+# driver and the kernel stack; keep the traffic running for both windows.
+# Then the empty programs utils/baseline_xdp.c and utils/baseline_tc_ingress.c are profiled with
+# BPF_PROG_TEST_RUN for --baseline-duration seconds: their cycles per packet (the cost of the
+# profiler and of running a program at all) are subtracted from XDP and TC programs respectively.
+# Prints JSON (or writes it to FILE):
+# {"stages": {<program>: {"packets", "cycles_per_packet", "instructions_per_packet",
+#   "llc_misses_per_packet", "counter_running_percent", "baseline_cycles_per_packet",
+#   "net_cycles_per_packet"}, ...},
+#  "tail_calls": {<program>: [<programs tail-calling it>]},
+#  "total": {"cycles_per_packet", "net_cycles_per_packet"}, "baseline": {...},
+#  "system": {"cpus", "packets", <perf event>: {"count", "per_packet"}, ...}}
+# Programs that did not run during the window have 0 packets and are not in the total.
+
+import argparse
+import ipaddress
+import json
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+import bpfsys
+from test_packets import frame
+
+BPF_PROG_TYPE_SCHED_CLS = 3
+BPF_PROG_TYPE_XDP = 6
+METRICS = ("cycles", "instructions", "llc_misses")
+PERF_EVENTS = ("cycles", "instructions", "cache-misses", "branch-misses")
+# source and 'bpftool prog load' type, libbpf >= 1.0 does not guess it from the legacy section names
+BASELINES = {BPF_PROG_TYPE_XDP: ("utils/baseline_xdp.c", "xdp"),
+             BPF_PROG_TYPE_SCHED_CLS: ("utils/baseline_tc_ingress.c", "tc")}
+REPO = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+
+def tail_calls(pipe, progs):
+    """Map name of a tail call target -> names of the programs using the BPF_MAP_TYPE_PROG_ARRAY
+    it is stored in. Programs pinned by the loader are entry programs, never targets."""
+    root = "/sys/fs/bpf/pipeline{}".format(pipe)
+    entries = set()
+    for name in os.listdir(root):
+        if not os.path.isdir(os.path.join(root, name)):
+            fd = bpfsys.obj_get(os.path.join(root, name))
+            try:
+                entries.add(bpfsys.prog_info(fd)[0].id)
+            finally:
+                os.close(fd)
+
+    arrays = {}
+    for name in os.listdir(os.path.join(root, "maps")):
+        fd = bpfsys.obj_get(os.path.join(root, "maps", name))
+        try:
+            info = bpfsys.map_info(fd)
+            if info.type != bpfsys.BPF_MAP_TYPE_PROG_ARRAY:
+                continue
+            # a lookup from user space returns the program ID
+            for slot in range(info.max_entries):
+                value = bpfsys.map_lookup(fd, struct.pack("=I", slot), 4)
+                if value is not None and struct.unpack("=I", value)[0] not in entries:
+                    arrays.setdefault(struct.unpack("=I", value)[0], set()).add(info.id)
+        finally:
+            os.close(fd)
+
+    map_ids = {}
+    for name, (prog_id, _) in progs.items():
+        fd = bpfsys.prog_fd_by_id(prog_id)
+        try:
+            map_ids[name] = set(bpfsys.prog_info(fd)[1])
+        finally:
+            os.close(fd)
+    return {name: sorted(n for n, ids in map_ids.items() if ids & arrays[prog_id] and n != name)
+            for name, (prog_id, _) in progs.items() if prog_id in arrays}
+
+
+def profile(prog_id, duration):
+    """Run 'bpftool prog profile' for duration seconds, returns {"run_cnt": n, <metric>: count,
+    "running": lowest percentage of the time the counters were on the PMU}."""
+    out = subprocess.run(["bpftool", "prog", "profile", "id", str(prog_id), "duration", str(int(duration))]
+                         + list(METRICS), capture_output=True, text=True).stdout
+    counts = {"run_cnt": 0, "running": 100.0}
+    counts.update({m: 0 for m in METRICS})
+    # a multiplexed counter is followed by the percentage of time it ran, e.g. "(83.87%)"
+    for v, m, pct in re.findall(r"^[ \t]*(\d+)[ \t]+(\w+)[ \t]*(?:\([ \t]*([\d.]+)%\))?", out, re.MULTILINE):
+        counts[m] = int(v)
+        if pct and m in METRICS:
+            counts["running"] = min(counts["running"], float(pct))
+            counts[m] = int(int(v) * 100 / float(pct)) if float(pct) else 0
+    return counts
+
+
+def perf_stat(duration, cpus):
+    if not shutil.which("perf"):
+        return {}
+    target = ["-C", cpus] if cpus else ["-a"]
+    # perf stat writes its CSV to stderr
+    err = subprocess.run(["perf", "stat", "-x", ",", "-e", ",".join(PERF_EVENTS)] + target
+                         + ["--", "sleep", str(duration)], capture_output=True, text=True).stderr
+    counts = {}
+    for line in err.splitlines():
+        fields = line.split(",")
+        if len(fields) > 2 and fields[2] in PERF_EVENTS and fields[0].isdigit():
+            counts[fields[2]] = int(fields[0])
+    return counts
+
+
+def per_packet(counts, packets):
+    return {m: counts[m] / packets if packets else 0 for m in METRICS}
+
+
+def measure_baseline(prog_type, duration, workdir):
+    """Cycles per packet of an empty program of prog_type under 'bpftool prog profile'."""
+    source, load_type = BASELINES[prog_type]
+    obj = os.path.join(workdir, os.path.basename(source)[:-2] + ".o")
+    pin = "/sys/fs/bpf/psa_baseline_{}".format(prog_type)
+    subprocess.run(["clang", "-O2", "-target", "bpf", "-c", os.path.join(REPO, source), "-o", obj], check=True)
+    # left behind by an interrupted run
+    if os.path.exists(pin):
+        os.unlink(pin)
+    subprocess.run(["bpftool", "prog", "load", obj, pin, "type", load_type], check=True)
+    try:
+        fd = bpfsys.obj_get(pin)
+        try:
+            prog_id = bpfsys.prog_info(fd)[0].id
+            stop = threading.Event()
+
+            def run():
+                packet = frame(ipaddress.IPv4Address("10.0.0.2"), 64)
+                while not stop.is_set():
+                    bpfsys.prog_test_run(fd, packet, 100000)
+
+            runner = threading.Thread(target=run)
+            runner.start()
+            try:
+                # let the runner start before the profiler attaches
+                time.sleep(0.2)
+                counts = profile(prog_id, duration)
+            finally:
+                stop.set()
+                runner.join()
+        finally:
+            os.close(fd)
+    finally:
+        os.unlink(pin)
+    return dict(per_packet(counts, counts["run_cnt"]), packets=counts["run_cnt"])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cycles per packet of the programs of a pipeline")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--duration", type=float, default=30, help="seconds to profile (default 30)")
+    parser.add_argument("--cpus", help="CPUs for perf stat, e.g. 6 or 6-9 (default all)")
+    parser.add_argument("--baseline-duration", type=float, default=5, help="seconds per baseline (default 5)")
+    parser.add_argument("--no-baseline", action="store_true", help="do not subtract baselines")
+    parser.add_argument("--output", help="JSON file (default stdout)")
+    args = parser.parse_args()
+
+    progs = bpfsys.pipeline_progs(args.pipe)
+    if not progs:
+        sys.exit("no programs of pipeline {}".format(args.pipe))
+    targets = tail_calls(args.pipe, progs)
+    progs = {name: (prog_id, info.type) for name, (prog_id, info) in progs.items() if name not in targets}
+
+    results = {}
+    threads = [threading.Thread(target=lambda n=name, i=prog_id: results.__setitem__(n, profile(i, args.duration)))
+               for name, (prog_id, _) in progs.items()]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    running = min((c["running"] for c in results.values()), default=100)
+    if running < 100:
+        print("PMU counters were multiplexed (running {:.2f}% of the time), counts are scaled; "
+              "profile fewer programs at once for exact counts".format(running), file=sys.stderr)
+    # in its own window, so that its counters do not compete with the ones of the profiler
+    system = perf_stat(args.duration, args.cpus)
+
+    baselines = {}
+    if not args.no_baseline:
+        with tempfile.TemporaryDirectory() as workdir:
+            for prog_type in sorted({t for _, t in progs.values() if t in BASELINES}):
+                baselines[prog_type] = measure_baseline(prog_type, args.baseline_duration, workdir)
+
+    stages = {}
+    total = {"cycles_per_packet": 0, "net_cycles_per_packet": 0}
+    for name, counts in sorted(results.items()):
+        packets = counts["run_cnt"]
+        stage = {"packets": packets}
+        stage.update({m + "_per_packet": v for m, v in per_packet(counts, packets).items()})
+        stage["counter_running_percent"] = counts["running"]
+        base = baselines.get(progs[name][1], {}).get("cycles", 0)
+        stage["baseline_cycles_per_packet"] = base
+        stage["net_cycles_per_packet"] = max(stage["cycles_per_packet"] - base, 0) if packets else 0
+        stages[name] = stage
+        if packets:
+            total["cycles_per_packet"] += stage["cycles_per_packet"]
+            total["net_cycles_per_packet"] += stage["net_cycles_per_packet"]
+
+    # every packet of the data path passes the program that ran most often
+    packets = max((c["run_cnt"] for c in results.values()), default=0)
+    report = {
+        "pipeline": args.pipe,
+        "duration": args.duration,
+        "stages": stages,
+        "tail_calls": targets,
+        "total": total,
+        "baseline": {BASELINES[t][0]: b for t, b in baselines.items()},
+        "system": dict({"cpus": args.cpus or "all", "packets": packets},
+                       **{e.replace("-", "_"): {"count": c, "per_packet": c / packets if packets else 0}
+                          for e, c in system.items()}),
+    }
+    text = json.dumps(report, indent=4)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
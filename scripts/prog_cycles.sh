@@ -0,0 +1,64 @@
+#!/bin/bash
+#
+# Cycles per packet of generated PSA-eBPF programs (.c files), without NICs.
+#
+# Usage: sudo -E ./scripts/prog_cycles.sh [-d DURATION] [-o RESULTS] [-a ADDRESS] [-s SIZE] [-c COMMANDS] \
+#            NAME:PROGRAM[:CFLAGS]...
+# Example: sudo -E ./scripts/prog_cycles.sh -o parser.txt \
+#              bitshift:p4testdata/01_use_cases/cycles/l2fwd/xdp/l2fwd-parser-only.c \
+#              zero-copy:p4testdata/01_use_cases/cycles/l2fwd/zero-copy/l2fwd-parser-only.c
+#
+# Every PROGRAM is compiled with kernel.mk (and CFLAGS) and loaded as pipeline 99 (no ports are
+# attached), then the COMMANDS file is run (e.g. to install table entries).
+# Ethernet/IPv4/UDP packets to ADDRESS (scripts/test_packets.py) are fed to xdp_ingress_func
+# with BPF_PROG_TEST_RUN while 'bpftool prog profile' counts cycles (scripts/test_run_lib.sh).
+# RESULTS gets one line per program: <name> <run_cnt> <cycles> <cycles per packet> <ns per packet>
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+DURATION=10
+RESULTS=prog_cycles.txt
+ADDRESS=10.0.0.2
+SIZE=64
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -a) ADDRESS="$2"; shift; shift ;;
+    -s) SIZE="$2"; shift; shift ;;
+    -c) COMMANDS="$2"; shift; shift ;;
+    -*) echo "Unknown option $1"; exit 1 ;;
+    *) break ;;
+  esac
+done
+
+if [[ $# -eq 0 || -z "$P4C_REPO" ]]; then
+  echo "Usage: $0 [-d DURATION] [-o RESULTS] [-a ADDRESS] [-s SIZE] [-c COMMANDS] NAME:PROGRAM[:CFLAGS]..."
+  echo "P4C_REPO must be set"
+  exit 1
+fi
+
+WORKDIR=$(mktemp -d)
+source scripts/test_run_lib.sh
+test_run_init
+
+echo "$ADDRESS" > "$WORKDIR/addresses"
+python3 scripts/test_packets.py --count 1 --size "$SIZE" "$WORKDIR/addresses" "$WORKDIR/packets"
+
+echo "# name run_cnt cycles cycles_per_packet ns_per_packet" > "$RESULTS"
+for arg in "$@"; do
+  IFS=: read -r NAME PROGRAM CFLAGS <<< "$arg"
+  test_run_unload
+  OBJ="$(test_run_build "$PROGRAM" "$CFLAGS")" || exit 1
+  test_run_load "$OBJ" || exit 1
+  if [[ -n "$COMMANDS" ]]; then
+    bash "$COMMANDS" > /dev/null || exit 1
+  fi
+
+  RESULT="$(test_run_measure xdp_ingress_fun --packets "$WORKDIR/packets" --repeat 100000)" || exit 1
+  echo "$NAME $(echo "$RESULT" | awk '{print $1, $2, $3, $4}')" | tee -a "$RESULTS"
+done
+
+test_run_unload
+rm -rf "$WORKDIR"
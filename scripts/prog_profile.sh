@@ -0,0 +1,44 @@
+#!/bin/bash
+#
+# Profile CPU cycles of loaded BPF programs for a fixed time window.
+#
+# Usage: prog_profile.sh DURATION PROG_NAME [PROG_NAME...]
+# Example: prog_profile.sh 30 xdp_ingress_fun xdp_egress_func
+#
+# PROG_NAME must be equal to the name shown by 'bpftool prog show' (truncated to 15 chars, longer
+# names are truncated before the comparison). If several programs have the name, the last loaded
+# one is profiled.
+# For each program prints: <name> <run_cnt> <cycles> <cycles per packet>
+
+if [ $# -lt 2 ]; then
+  echo "Usage: $0 DURATION PROG_NAME [PROG_NAME...]"
+  exit 1
+fi
+
+DURATION=$1
+shift
+
+TMPDIR=$(mktemp -d)
+
+for name in "$@"; do
+  PROG_ID="$(bpftool prog show | awk -v n="${name:0:15}" '$3 == "name" && $4 == n {id = $1} END {print id}' | tr -d :)"
+  if [ -z "$PROG_ID" ]; then
+    echo "Program $name not found" >&2
+    continue
+  fi
+  bpftool prog profile id "$PROG_ID" duration "$DURATION" cycles > "$TMPDIR/$name" 2>&1 &
+done
+wait
+
+for name in "$@"; do
+  [ -f "$TMPDIR/$name" ] || continue
+  RUN_CNT="$(awk '$2 == "run_cnt" {print $1}' "$TMPDIR/$name")"
+  CYCLES="$(awk '$2 == "cycles" {print $1}' "$TMPDIR/$name")"
+  if [ -z "$RUN_CNT" ] || [ "$RUN_CNT" -eq 0 ]; then
+    echo "$name 0 ${CYCLES:-0} 0"
+    continue
+  fi
+  echo "$name $RUN_CNT $CYCLES $(awk -v c="$CYCLES" -v n="$RUN_CNT" 'BEGIN {printf "%.2f", c / n}')"
+done
+
+rm -rf "$TMPDIR"
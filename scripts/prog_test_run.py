@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+#
+# Replay packets through programs of a loaded PSA-eBPF pipeline with BPF_PROG_TEST_RUN.
+#
+# Usage:
+#   sudo python3 scripts/prog_test_run.py [--pipe 99] [--duration 10] [--repeat 1000]
+#       [--live] [--batch-size 64] (--pcap FILE | --packets DIR | --addresses FILE [--count 64] [--size 64])
+#       PROGRAM...
+#
+# PROGRAMs are names as shown by 'bpftool prog' (e.g. xdp_ingress_fun, tc_ingress_func) of the
+# programs of pipeline --pipe. Packets are read from a pcap file
+# (Ethernet, pcapng is not supported), from the pkt-<n>.bin files of scripts/test_packets.py, or
+# synthesized from an addresses file like scripts/test_packets.py does.
+# Every packet is run --repeat times per BPF_PROG_TEST_RUN call, cycling over all packets until
+# --duration seconds have passed (so that 'bpftool prog profile' can count cycles meanwhile).
+# With --live, XDP programs are run in live frames mode (BPF_F_TEST_XDP_LIVE_FRAMES): packets
+# are really sent or redirected according to the verdict and --batch-size frames are run at once.
+# Prints one line per program:
+# <name> <packets> <ns per packet> <verdicts as retval:percent,...>
+# In live frames mode the verdict only tells what the kernel did with the frame, so "-" is
+# printed instead.
+
+import argparse
+import ipaddress
+import os
+import random
+import struct
+import sys
+import time
+
+import bpfsys
+from test_packets import frame
+
+BPF_PROG_TYPE_XDP = 6
+LINKTYPE_ETHERNET = 1
+
+
+def read_pcap(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic = data[:4]
+    for endian in "<>":
+        (m,) = struct.unpack(endian + "I", magic)
+        if m in (0xa1b2c3d4, 0xa1b23c4d):
+            break
+    else:
+        raise ValueError("{}: not a pcap file".format(path))
+    linktype = struct.unpack(endian + "I", data[20:24])[0]
+    if linktype != LINKTYPE_ETHERNET:
+        raise ValueError("{}: link type {} is not Ethernet".format(path, linktype))
+    packets = []
+    offset = 24
+    while offset + 16 <= len(data):
+        _, _, caplen, _ = struct.unpack(endian + "IIII", data[offset:offset + 16])
+        packets.append(data[offset + 16:offset + 16 + caplen])
+        offset += 16 + caplen
+    return packets
+
+
+def read_packets(path):
+    names = sorted((n for n in os.listdir(path) if n.startswith("pkt-") and n.endswith(".bin")),
+                   key=lambda n: int(n[4:-4]))
+    packets = []
+    for n in names:
+        with open(os.path.join(path, n), "rb") as f:
+            packets.append(f.read())
+    return packets
+
+
+def synthesize(path, count, size):
+    with open(path) as f:
+        addrs = [ipaddress.IPv4Address(l.strip()) for l in f if l.strip()]
+    rng = random.Random(1)
+    return [frame(rng.choice(addrs), size) for _ in range(count)]
+
+
+def run(fd, packets, duration, repeat, flags, batch_size):
+    verdicts = {}
+    total_ns = 0
+    runs = 0
+    end = time.monotonic() + duration
+    while True:
+        for pkt in packets:
+            retval, ns = bpfsys.prog_test_run(fd, pkt, repeat, flags, batch_size)
+            verdicts[retval] = verdicts.get(retval, 0) + repeat
+            total_ns += ns * repeat
+            runs += repeat
+        if time.monotonic() >= end:
+            return runs, total_ns, verdicts
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BPF_PROG_TEST_RUN benchmark of pipeline programs")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--duration", type=float, default=10, help="seconds per program (default 10)")
+    parser.add_argument("--repeat", type=int, default=1000, help="runs per packet and call (default 1000)")
+    parser.add_argument("--live", action="store_true", help="XDP live frames mode")
+    parser.add_argument("--batch-size", type=int, default=0, help="frames per batch in live frames mode")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--pcap", help="pcap file to replay")
+    source.add_argument("--packets", help="directory with pkt-<n>.bin files")
+    source.add_argument("--addresses", help="file with destination addresses of synthesized packets")
+    parser.add_argument("--count", type=int, default=64, help="number of synthesized packets (default 64)")
+    parser.add_argument("--size", type=int, default=64, help="size of synthesized packets (default 64)")
+    parser.add_argument("programs", nargs="+", help="program names")
+    args = parser.parse_args()
+
+    if args.pcap:
+        packets = read_pcap(args.pcap)
+    elif args.packets:
+        packets = read_packets(args.packets)
+    else:
+        packets = synthesize(args.addresses, args.count, args.size)
+    if not packets:
+        sys.exit("No packets")
+
+    progs = bpfsys.pipeline_progs(args.pipe)
+    for name in args.programs:
+        if name[:15] not in progs:
+            print("Program {} not found".format(name), file=sys.stderr)
+            continue
+        prog_id, info = progs[name[:15]]
+        flags = 0
+        batch_size = 0
+        if args.live and info.type == BPF_PROG_TYPE_XDP:
+            flags = bpfsys.BPF_F_TEST_XDP_LIVE_FRAMES
+            batch_size = args.batch_size
+        fd = bpfsys.prog_fd_by_id(prog_id)
+        try:
+            runs, total_ns, verdicts = run(fd, packets, args.duration, args.repeat, flags, batch_size)
+        finally:
+            os.close(fd)
+        if flags & bpfsys.BPF_F_TEST_XDP_LIVE_FRAMES:
+            verdicts = "-"
+        else:
+            verdicts = ",".join("{}:{:.1f}".format(r, 100 * n / runs) for r, n in sorted(verdicts.items()))
+        print(name, runs, "{:.2f}".format(total_ns / runs), verdicts)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
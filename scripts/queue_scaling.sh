@@ -0,0 +1,47 @@
+#!/bin/bash
+#
+# Measure cycles per packet of pipeline variants at a growing number of RX/TX queues.
+#
+# Usage: sudo -E ./scripts/queue_scaling.sh -E <ENV-FILE> -C <CORES> [-d DURATION] [-q "1 2 4 8"] [-o RESULTS] \
+#            [-P PROGRAMS] NAME:PROGRAM:COMMANDS[:CFLAGS] [NAME:PROGRAM:COMMANDS[:CFLAGS]...]
+#
+# Each variant is deployed by setup_test.sh with PROGRAM and the COMMANDS runtime file
+# (and CFLAGS passed with --cflags). All PROGRAMS (default "xdp_ingress_fun", e.g.
+# "xdp_ingress_fun xdp_egress_func" when the change is in the egress) are profiled in the same
+# window, RESULTS gets one line per variant, number of queues and program:
+# <variant> <queues> <program> <run_cnt> <cycles> <cycles per packet>
+# For each run, start the generator with a multi-flow profile once asked, so that
+# traffic is spread over all queues (see README, section 07).
+
+DURATION=30
+QUEUES="1 2 4 8"
+RESULTS=queue_scaling.txt
+PROGRAMS=xdp_ingress_fun
+
+POSITIONAL=()
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -E) ENV_FILE="$2"; shift; shift ;;
+    -C) CORES="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -q) QUEUES="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -P) PROGRAMS="$2"; shift; shift ;;
+    *) POSITIONAL+=("$1"); shift ;;
+  esac
+done
+
+if [[ -z "$ENV_FILE" || -z "$CORES" || ${#POSITIONAL[@]} -eq 0 ]]; then
+  echo "Usage: $0 -E <ENV-FILE> -C <CORES> [-d DURATION] [-q \"1 2 4 8\"] [-o RESULTS] [-P PROGRAMS] NAME:PROGRAM:COMMANDS..."
+  exit 1
+fi
+
+echo "# variant queues program run_cnt cycles cycles_per_packet" > "$RESULTS"
+for queues in $QUEUES; do
+  for variant in "${POSITIONAL[@]}"; do
+    IFS=':' read -r name program commands cflags <<< "$variant"
+    ./setup_test.sh -C "$CORES" -q "$queues" --target psa-ebpf -E "$ENV_FILE" -c "$commands" --cflags "$cflags" "$program" > /dev/null
+    read -p "[$name, $queues queues] Start traffic on the generator and press Enter.."
+    bash scripts/prog_profile.sh "$DURATION" $PROGRAMS | awk -v v="$name" -v q="$queues" '{print v, q, $0}' | tee -a "$RESULTS"
+  done
+done
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#
+# Read the per-stage latency histograms of a pipeline built with -DSTAGE_LATENCY (see
+# p4testdata/01_use_cases/cycles/l2l3-acl/stage-latency).
+#
+# Usage:
+#   sudo python3 scripts/stage_latency.py [--pipe 99] [--interval SECONDS] [--hdr DIR]
+#   sudo python3 scripts/stage_latency.py [--pipe 99] --reset
+#
+# The histograms are summed over all CPUs. With --interval, they are reset first and read after
+# SECONDS, otherwise they hold everything since the pipeline was loaded. Prints one line per stage
+# with samples:
+# <stage> <count> <min> <p50> <p90> <p99> <p99.9> <max> (latency in us)
+# --hdr writes the percentile distribution of every stage to DIR/<stage>.hdr in the format of
+# HdrHistogram (and scripts/xsk_gen.c -H), so the stages can be plotted like the TRex --hdrh results.
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+import bpfsys
+
+# same order as STAGE_* in the generated code
+STAGES = ("xdp_ingress", "devmap_hop", "xdp_egress", "xdp_to_tc", "tc_ingress", "tc_hop", "tc_egress")
+SUB_BITS = 4
+SUB_BUCKETS = 1 << SUB_BITS
+BUCKETS = 512
+
+
+def bucket_value(bucket):
+    """Highest latency in ns counted in bucket."""
+    if bucket < SUB_BUCKETS:
+        return bucket
+    shift = bucket // SUB_BUCKETS - 1
+    return ((SUB_BUCKETS + bucket % SUB_BUCKETS) << shift) + (1 << shift) - 1
+
+
+def bucket_low(bucket):
+    """Lowest latency in ns counted in bucket."""
+    if bucket < SUB_BUCKETS:
+        return bucket
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS) << (bucket // SUB_BUCKETS - 1)
+
+
+def read_histograms(fd):
+    cpus = bpfsys.possible_cpus()
+    histograms = []
+    for stage in range(len(STAGES)):
+        counts = []
+        for bucket in range(BUCKETS):
+            data = bpfsys.map_lookup(fd, struct.pack("=I", stage * BUCKETS + bucket), 8 * cpus)
+            counts.append(sum(struct.unpack("={}Q".format(cpus), data)) if data else 0)
+        histograms.append(counts)
+    return histograms
+
+
+def reset(fd):
+    zeros = bytes(8 * bpfsys.possible_cpus())
+    for key in range(len(STAGES) * BUCKETS):
+        bpfsys.map_update(fd, struct.pack("=I", key), zeros)
+
+
+def percentile(counts, total, p):
+    target = max(1, int(p / 100 * total + 0.5))
+    seen = 0
+    for bucket, n in enumerate(counts):
+        seen += n
+        if seen >= target:
+            return bucket_value(bucket) / 1000
+    return 0
+
+
+def write_hdr(path, counts):
+    """Percentile distribution like hdr_percentiles_print(), 5 ticks per half distance."""
+    total = sum(counts)
+    mean = sum(bucket_value(b) * n for b, n in enumerate(counts)) / total
+    variance = sum((bucket_value(b) - mean) ** 2 * n for b, n in enumerate(counts)) / total
+    maximum = max(b for b, n in enumerate(counts) if n)
+    with open(path, "w") as f:
+        f.write("{:>12} {:>12} {:>12} {:>12}\n\n".format("Value", "Percentile", "TotalCount", "1/(1-Percentile)"))
+        seen = 0
+        next_percentile = 0.0
+        for bucket, n in enumerate(counts):
+            if not n:
+                continue
+            seen += n
+            value = bucket_value(bucket) / 1000
+            pct = 100 * seen / total
+            while pct >= next_percentile and seen < total:
+                f.write("{:12.3f} {:2.12f} {:10d} {:14.2f}\n".format(value, pct / 100, seen, 1 / (1 - pct / 100)))
+                ticks = 10
+                reciprocal = 100 / (100 - next_percentile)
+                while reciprocal >= 2:
+                    ticks *= 2
+                    reciprocal /= 2
+                next_percentile += 100 / ticks
+            if seen == total:
+                f.write("{:12.3f} {:2.12f} {:10d}\n".format(value, 1.0, seen))
+        f.write("#[Mean    = {:12.3f}, StdDeviation   = {:12.3f}]\n".format(mean / 1000, variance ** 0.5 / 1000))
+        f.write("#[Max     = {:12.3f}, Total count    = {:12d}]\n".format(bucket_value(maximum) / 1000, total))
+        f.write("#[Buckets = {:12d}, SubBuckets     = {:12d}]\n".format(BUCKETS // SUB_BUCKETS, SUB_BUCKETS))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Per-stage latency histograms of a pipeline")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--interval", type=float, help="reset, wait SECONDS and read")
+    parser.add_argument("--hdr", help="directory for HdrHistogram percentile distributions")
+    parser.add_argument("--reset", action="store_true", help="only reset the histograms")
+    args = parser.parse_args()
+
+    path = "/sys/fs/bpf/pipeline{}/maps/stage_latency".format(args.pipe)
+    if not os.path.exists(path):
+        sys.exit("{} not found, is the pipeline built with -DSTAGE_LATENCY?".format(path))
+    fd = bpfsys.obj_get(path)
+    try:
+        if args.reset or args.interval:
+            reset(fd)
+        if args.reset:
+            return 0
+        if args.interval:
+            time.sleep(args.interval)
+        histograms = read_histograms(fd)
+    finally:
+        os.close(fd)
+
+    if args.hdr:
+        os.makedirs(args.hdr, exist_ok=True)
+    print("# stage count min_us p50_us p90_us p99_us p99.9_us max_us")
+    for name, counts in zip(STAGES, histograms):
+        total = sum(counts)
+        if not total:
+            continue
+        first = min(b for b, n in enumerate(counts) if n)
+        last = max(b for b, n in enumerate(counts) if n)
+        print(name, total, *("{:.3f}".format(v) for v in (
+            bucket_low(first) / 1000, percentile(counts, total, 50), percentile(counts, total, 90),
+            percentile(counts, total, 99), percentile(counts, total, 99.9), bucket_value(last) / 1000)))
+        if args.hdr:
+            write_hdr(os.path.join(args.hdr, name + ".hdr"), counts)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
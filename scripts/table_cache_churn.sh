@@ -0,0 +1,67 @@
+#!/bin/bash
+#
+# Measure table cache hit rate and cycles per packet while PDR rules are
+# updated at a steady rate. Run after deploying the UPF uplink pipeline, e.g.:
+#
+# sudo -E ./setup_test.sh -C 6 --target psa-ebpf -E <ENV-FILE> -c runtime_cmd/01_use_cases/upf_ul.txt \
+#     p4testdata/01_use_cases/cycles/upf/table-caching-gen/upf-ig-control.c
+#
+# Usage: sudo -E ./scripts/table_cache_churn.sh [-r UPDATES_PER_SEC] [-d DURATION]
+#
+# A PDR rule is added and deleted alternately through scripts/table_ctl.sh, one write every
+# 1/UPDATES_PER_SEC seconds measured from the start (a late write is not made up for by
+# sleeping less later, it is just not followed by a sleep). Every write forks psabpf-ctl and
+# the table_ctl.sh helpers, so the achieved rate is printed next to cycles/packet.
+
+RATE=10
+DURATION=30
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -r) RATE="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    *) echo "Unknown option $1"; exit 1 ;;
+  esac
+done
+
+TABLE=ingress_upf_ingress_pdr_lookup
+KEY="0x00 0x0b0b0b0b^0xffffffff 0^0 0^0 0^0 0^0 0x00"
+
+function churn() {
+  local period_ns start now next end writes=0
+  period_ns=$(awk -v r="$RATE" 'BEGIN {printf "%d", 1e9 / r}')
+  start=$(date +%s%N)
+  end=$((start + DURATION * 1000000000))
+  next=$start
+  while true; do
+    if (( writes % 2 == 0 )); then
+      ./scripts/table_ctl.sh table add pipe 99 $TABLE id 1 key $KEY data 0x0000000c priority 1 > /dev/null
+    else
+      ./scripts/table_ctl.sh table delete pipe 99 $TABLE key $KEY > /dev/null
+    fi
+    writes=$((writes + 1))
+    next=$((next + period_ns))
+    now=$(date +%s%N)
+    (( now >= end )) && break
+    if (( next > now )); then
+      sleep "$(awk -v ns="$((next - now))" 'BEGIN {printf "%.6f", ns / 1e9}')"
+    fi
+  done
+  # leave the table as it was
+  (( writes % 2 == 1 )) && ./scripts/table_ctl.sh table delete pipe 99 $TABLE key $KEY > /dev/null
+  awk -v n="$writes" -v ns="$((now - start))" -v r="$RATE" \
+    'BEGIN {printf "table writes: %d in %.2f s, %.2f/s (requested %s/s)\n", n, ns / 1e9, n / (ns / 1e9), r}'
+}
+
+churn &
+CHURN_PID=$!
+
+bash scripts/prog_profile.sh "$DURATION" xdp_ingress_fun | awk '{print "cycles/packet: " $4}' &
+PROFILE_PID=$!
+python3 scripts/table_cache_stats.py --interval "$DURATION" &
+STATS_PID=$!
+
+wait $PROFILE_PID $CHURN_PID
+sleep 1
+kill $STATS_PID
+wait 2> /dev/null
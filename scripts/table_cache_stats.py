@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+#
+# Report hit rate and flow cardinality of table caches generated with
+# generation numbers (see p4testdata/01_use_cases/cycles/upf/table-caching-gen).
+#
+# Usage:
+#   sudo python3 scripts/table_cache_stats.py [--pipe 99] [--interval 1] [--defines]
+#
+# --defines prints only the -D flags that size each cache from the observed
+#           number of flows, e.g. for: setup_test.sh --cflags "$(... --defines)"
+
+import argparse
+import glob
+import json
+import math
+import os
+import subprocess
+import sys
+import time
+
+SKETCH_BITS = 1024 * 64
+MIN_CACHE_SIZE = 512
+
+
+def map_dump(path):
+    out = subprocess.check_output(["bpftool", "-j", "map", "dump", "pinned", path])
+    return json.loads(out)
+
+
+def to_int(raw_bytes):
+    return int.from_bytes(bytes(int(b, 16) for b in raw_bytes), byteorder=sys.byteorder)
+
+
+def read_stats(path):
+    # struct table_cache_stats { u64 hits; u64 misses; }, per CPU; stale entries are misses
+    hits, misses = 0, 0
+    for entry in map_dump(path):
+        for cpu in entry["values"]:
+            value = cpu["value"]
+            hits += to_int(value[0:8])
+            misses += to_int(value[8:16])
+    return hits, misses
+
+
+def estimate_flows(path):
+    zero_bits = 0
+    for entry in map_dump(path):
+        zero_bits += 64 - bin(to_int(entry["value"])).count("1")
+    if zero_bits == 0:
+        return SKETCH_BITS * math.log(SKETCH_BITS)
+    return -SKETCH_BITS * math.log(zero_bits / SKETCH_BITS)
+
+
+def cache_size(flows):
+    # keep the LRU at most half full for the observed flows
+    size = MIN_CACHE_SIZE
+    while size < 2 * flows:
+        size *= 2
+    return size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Table cache statistics")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--interval", type=float, default=0,
+                        help="print hit rate every INTERVAL seconds (default: print once)")
+    parser.add_argument("--defines", action="store_true",
+                        help="print -D flags with cache sizes derived from observed flows")
+    args = parser.parse_args()
+
+    maps_dir = "/sys/fs/bpf/pipeline{}/maps".format(args.pipe)
+    tables = sorted(os.path.basename(p)[:-len("_cache_stats")]
+                    for p in glob.glob(os.path.join(maps_dir, "*_cache_stats")))
+    if not tables:
+        print("No table caches found in {}".format(maps_dir), file=sys.stderr)
+        return 1
+
+    if args.defines:
+        print(" ".join("-D{}_CACHE_SIZE={}".format(t.upper(), cache_size(
+            estimate_flows(os.path.join(maps_dir, t + "_cache_flows")))) for t in tables))
+        return 0
+
+    previous = {t: read_stats(os.path.join(maps_dir, t + "_cache_stats")) for t in tables}
+    while True:
+        if args.interval:
+            time.sleep(args.interval)
+        for t in tables:
+            hits, misses = read_stats(os.path.join(maps_dir, t + "_cache_stats"))
+            if args.interval:
+                prev_hits, prev_misses = previous[t]
+                previous[t] = (hits, misses)
+                hits, misses = hits - prev_hits, misses - prev_misses
+            total = hits + misses
+            flows = estimate_flows(os.path.join(maps_dir, t + "_cache_flows"))
+            print("{}: hits {} misses {} hit rate {:.2f}% flows ~{:.0f} cache size {}".format(
+                t, hits, misses, 100.0 * hits / total if total else 0.0, flows, cache_size(flows)))
+        if not args.interval:
+            return 0
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
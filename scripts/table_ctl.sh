@@ -0,0 +1,85 @@
+#!/bin/bash
+#
+# Drop-in replacement for psabpf-ctl that invalidates table caches after a table write.
+# If the table has a generation map (<table>_cache_gen), the generation is bumped
+# after a successful 'table add|update|delete' or 'table default set' (default action
+# results are cached too), so the data path treats every entry cached before the write
+# as a miss. The cache itself is not flushed.
+# The generation of the ingress flow cache (ingress_flow_cache_gen) caches results of the
+# whole control block, so it is bumped after a successful write of any table, action
+# profile or action selector.
+# If the table has tuples ordered by priority (<table>_tuples_sorted), early termination
+# of the tuple walk is disabled during the write and the tuples are ordered again after it.
+# Per-CPU side maps of direct counters (<table>_<counter>) lose the entries of deleted table
+# entries before a 'table add' and after a 'table delete' (scripts/counter_get.py counter prune).
+#
+# Example: scripts/table_ctl.sh table add pipe 99 ingress_upf_ingress_pdr_lookup id 1 key ...
+
+function bump_generation() {
+  local gen
+  if [ -e "$1" ]; then
+    gen="$(bpftool -j map lookup pinned "$1" key 0 0 0 0 | python3 -c \
+      'import json, sys; print(int.from_bytes(bytes(int(b, 16) for b in json.load(sys.stdin)["value"]), sys.byteorder))')"
+    gen=$(( (gen + 1) & 0xffffffff ))
+    bpftool map update pinned "$1" key 0 0 0 0 value \
+      $((gen & 0xff)) $(((gen >> 8) & 0xff)) $(((gen >> 16) & 0xff)) $(((gen >> 24) & 0xff))
+  fi
+}
+
+# Whether a per-CPU side map of a direct counter of table $2 in pipeline $1 is pinned, so that
+# tables without direct counters do not start counter_get.py on every write
+function has_counter_side_map() {
+  for map in /sys/fs/bpf/pipeline$1/maps/${2}_*; do
+    [[ -e "$map" && "$map" != *_defaultAction ]] || continue
+    if bpftool -j map show pinned "$map" 2> /dev/null | grep -q '"type":"percpu_hash"'; then
+      return 0
+    fi
+  done
+  return 1
+}
+
+TABLE_WRITE=0
+SORTED_MAP=""
+if [[ "$1" == "table" && ( "$2" == "add" || "$2" == "update" || "$2" == "delete" ) && "$3" == "pipe" ]]; then
+  TABLE_WRITE=1
+  TABLE_PIPE="$4"
+  TABLE_NAME="$5"
+  SORTED_MAP="/sys/fs/bpf/pipeline$4/maps/${5}_tuples_sorted"
+  if [ -e "$SORTED_MAP" ]; then
+    bpftool map update pinned "$SORTED_MAP" key 0 0 0 0 value 0 0 0 0
+  fi
+elif [[ "$1" == "table" && "$2" == "default" && "$3" == "set" && "$4" == "pipe" ]]; then
+  TABLE_WRITE=1
+  TABLE_PIPE="$5"
+  TABLE_NAME="$6"
+fi
+
+COUNTER_SIDE_MAP=0
+if [[ "$1" == "table" && ( "$2" == "add" || "$2" == "delete" ) && $TABLE_WRITE -eq 1 ]] && has_counter_side_map "$TABLE_PIPE" "$TABLE_NAME"; then
+  COUNTER_SIDE_MAP=1
+fi
+if [[ "$2" == "add" && $COUNTER_SIDE_MAP -eq 1 ]]; then
+  # entries deleted without this script, or counted by packets in flight during the delete
+  python3 "$(dirname "$0")/counter_get.py" counter prune pipe "$TABLE_PIPE" "$TABLE_NAME"
+fi
+
+psabpf-ctl "$@"
+ret=$?
+
+if [[ -n "$SORTED_MAP" && -e "$SORTED_MAP" ]]; then
+  python3 "$(dirname "$0")/ternary_reorder.py" --pipe "$TABLE_PIPE" "$TABLE_NAME" > /dev/null
+fi
+if [ $ret -ne 0 ]; then
+  exit $ret
+fi
+
+if [[ "$2" == "delete" && $COUNTER_SIDE_MAP -eq 1 ]]; then
+  python3 "$(dirname "$0")/counter_get.py" counter prune pipe "$TABLE_PIPE" "$TABLE_NAME"
+fi
+if [ $TABLE_WRITE -eq 1 ]; then
+  bump_generation "/sys/fs/bpf/pipeline$TABLE_PIPE/maps/${TABLE_NAME}_cache_gen"
+fi
+if [[ ( "$1" == "table" || "$1" == "action-profile" || "$1" == "action-selector" ) && "$2" != "get" ]]; then
+  PIPE_ID="$(echo "$@" | awk '{for (i = 1; i < NF; i++) if ($i == "pipe") {print $(i + 1); exit}}')"
+  bump_generation "/sys/fs/bpf/pipeline$PIPE_ID/maps/ingress_flow_cache_gen"
+fi
@@ -0,0 +1,377 @@
+#!/usr/bin/env python3
+#
+# Bulk loader for PSA-eBPF tables: installs many 'psabpf-ctl table add' entries with
+# BPF_MAP_UPDATE_BATCH instead of one psabpf-ctl process per entry.
+#
+# Usage:
+#   sudo python3 scripts/table_load.py [FILE]
+#
+# Every line of FILE (or stdin) holds the arguments of one psabpf-ctl call:
+#   table add pipe <ID> <TABLE> [id <ACTION-ID>] key <FIELD>... [data <PARAM>...] [priority <P>]
+# e.g. as printed by 'scripts/table_load.sh' for a runtime_cmd file. Key fields are exact
+# values, <value>/<prefix length> (LPM) or <value>^<mask> (ternary); values are integers,
+# IPv4 or MAC addresses. Entries with an action ID of exact, LPM and ternary tables are packed;
+# for ternary tables missing tuples are created and linked into <TABLE>_prefixes like psabpf-ctl
+# does. Other lines (e.g. 'ref' entries of tables with an action profile or selector) are run
+# with psabpf-ctl; the entries packed before them are installed first, so lines take effect
+# in the order of FILE.
+# Ternary tables with shadow instances (<TABLE>_prefixes_set) are replaced as a whole:
+# the entries are written to a new instance, which is then published with a single map update.
+# Key and value layouts are taken from the BTF of the pipeline.
+#
+# For every table the number of entries, the time and the rate are reported.
+
+import argparse
+import collections
+import ipaddress
+import json
+import os
+import subprocess
+import sys
+import time
+
+import bpfsys
+
+# time given to packets in flight before tuples of a replaced table are released, in seconds
+SHADOW_GRACE_PERIOD = 0.1
+
+
+class BTF:
+    def __init__(self, btf_id):
+        out = subprocess.check_output(["bpftool", "-j", "btf", "dump", "id", str(btf_id)])
+        self.types = {t["id"]: t for t in json.loads(out)["types"]}
+
+    def resolve(self, type_id):
+        t = self.types[type_id]
+        while t["kind"] in ("TYPEDEF", "VOLATILE", "CONST", "RESTRICT"):
+            t = self.types[t["type_id"]]
+        return t
+
+    def size(self, type_id):
+        t = self.resolve(type_id)
+        if t["kind"] == "ARRAY":
+            return t["nr_elems"] * self.size(t["type_id"])
+        return t["size"]
+
+    def members(self, type_id):
+        # [(name, byte offset, size, type_id)]
+        return [(m["name"], m["bits_offset"] // 8, self.size(m["type_id"]), m["type_id"])
+                for m in self.resolve(type_id)["members"]]
+
+    def find_struct(self, name):
+        for type_id, t in self.types.items():
+            if t["kind"] == "STRUCT" and t["name"] == name:
+                return type_id
+        raise KeyError("struct {} not found in BTF".format(name))
+
+
+def parse_value(s):
+    if "." in s:
+        return int(ipaddress.IPv4Address(s))
+    if ":" in s:
+        return int(s.replace(":", ""), 16)
+    return int(s, 0)
+
+
+def pack(value, size, byteorder=sys.byteorder):
+    return (value & ((1 << (8 * size)) - 1)).to_bytes(size, byteorder)
+
+
+class Unsupported(ValueError):
+    pass
+
+
+class Table:
+    def __init__(self, maps_dir, name):
+        self.maps_dir = maps_dir
+        self.name = name
+        # every table has a default action map with the table value type
+        fd = bpfsys.obj_get(self.path("defaultAction"))
+        info = bpfsys.map_info(fd)
+        os.close(fd)
+        self.btf = BTF(info.btf_id)
+        self.value_size = info.value_size
+        self.value = {m[0]: m for m in self.btf.members(info.btf_value_type_id)}
+        if "action" not in self.value or "u" not in self.value:
+            # tables with an action profile or selector hold references instead of actions
+            raise Unsupported("{}: no action in the table value".format(name))
+        self.actions = self.btf.members(self.value["u"][3])
+        self.key_type = self.btf.find_struct(name + "_key")
+        self.key_size = self.btf.size(self.key_type)
+        self.key = [m for m in self.btf.members(self.key_type) if m[0] != "prefixlen"]
+        self.shadow = os.path.exists(self.path("prefixes_set"))
+        self.ternary = self.shadow or os.path.exists(self.path("prefixes"))
+
+    def path(self, suffix=None):
+        return os.path.join(self.maps_dir, self.name + ("_" + suffix if suffix else ""))
+
+    def pack_entry(self, args):
+        action, key, data, priority = 0, [], [], 0
+        i = 0
+        while i < len(args):
+            if args[i] == "id":
+                action = int(args[i + 1], 0)
+                i += 2
+            elif args[i] == "priority":
+                priority = int(args[i + 1], 0)
+                i += 2
+            elif args[i] in ("key", "data"):
+                target = key if args[i] == "key" else data
+                i += 1
+                while i < len(args) and args[i] not in ("id", "key", "data", "priority"):
+                    target.append(args[i])
+                    i += 1
+            else:
+                # e.g. 'ref' and 'data group <ID>' of action profile/selector entries
+                raise Unsupported("unsupported argument {}".format(args[i]))
+        if len(key) != len(self.key):
+            raise ValueError("{}: expected {} key fields, got {}".format(self.name, len(self.key), len(key)))
+
+        k, mask = bytearray(self.key_size), bytearray(self.key_size)
+        prefixlen = None
+        for (_, offset, size, _), field in zip(self.key, key):
+            if "/" in field:
+                value, length = field.split("/")
+                k[offset:offset + size] = pack(parse_value(value), size, "big")
+                # the prefix covers the preceding fields (and padding) after 'prefixlen'
+                prefixlen = (offset - 4) * 8 + int(length)
+                continue
+            value, m = field.split("^") if "^" in field else (field, None)
+            m = (1 << (8 * size)) - 1 if m is None else parse_value(m)
+            k[offset:offset + size] = pack(parse_value(value) & m, size)
+            mask[offset:offset + size] = pack(m, size)
+        if prefixlen is not None:
+            k[0:4] = pack(prefixlen, 4)
+
+        v = bytearray(self.value_size)
+        v[self.value["action"][1]:self.value["action"][1] + 4] = pack(action, 4)
+        if "priority" in self.value:
+            v[self.value["priority"][1]:self.value["priority"][1] + 4] = pack(priority, 4)
+        if data:
+            params = self.btf.members(self.actions[action][3])
+            base = self.value["u"][1]
+            for (_, offset, size, _), param in zip(params, data):
+                v[base + offset:base + offset + size] = pack(parse_value(param), size)
+        return bytes(mask), bytes(k), bytes(v)
+
+    def load(self, entries):
+        if self.shadow:
+            return self.load_shadow(entries)
+        if self.ternary:
+            return self.load_ternary(entries)
+        fd = bpfsys.obj_get(self.path())
+        try:
+            return bpfsys.map_update_batch(fd, [k for _, k, _ in entries], [v for _, _, v in entries])
+        finally:
+            os.close(fd)
+
+    def group_by_mask(self, entries, mask_size):
+        # key_mask may be padded beyond the key size
+        by_mask = collections.OrderedDict()
+        for mask, k, v in entries:
+            if not any(mask):
+                raise ValueError("{}: entries without any masked bit are not supported".format(self.name))
+            by_mask.setdefault(mask.ljust(mask_size, b"\0"), []).append((k, v))
+        return by_mask
+
+    def walk(self, prefixes_fd, prefixes_info, vm):
+        # walk the list of tuples from the head (all-zero mask) to the tail,
+        # returns ({mask: tuple_id}, tail mask, tail value)
+        mask_size = prefixes_info.key_size
+        existing, tail = collections.OrderedDict(), bytes(mask_size)
+        tail_node = bpfsys.map_lookup(prefixes_fd, tail, prefixes_info.value_size)
+        while tail_node is not None and tail_node[vm["has_next"]]:
+            next_mask = tail_node[vm["next_tuple_mask"]:vm["next_tuple_mask"] + mask_size]
+            node = bpfsys.map_lookup(prefixes_fd, next_mask, prefixes_info.value_size)
+            if node is None:
+                break
+            tail, tail_node = next_mask, node
+            existing[tail] = int.from_bytes(node[vm["tuple_id"]:vm["tuple_id"] + 4], sys.byteorder)
+        return existing, tail, tail_node
+
+    def add_tuple(self, tuples_fd, tuple_id, items):
+        # a new tuple map is filled before it is visible in <table>_tuples_map
+        inner_fd = bpfsys.map_create(bpfsys.BPF_MAP_TYPE_HASH, self.key_size, self.value_size,
+                                     max(self.tuple_size(), len(items)))
+        try:
+            batched = bpfsys.map_update_batch(inner_fd, [k for k, _ in items], [v for _, v in items])
+            bpfsys.map_update(tuples_fd, pack(tuple_id, 4), pack(inner_fd, 4))
+            return batched
+        finally:
+            os.close(inner_fd)
+
+    @staticmethod
+    def value_mask(prefixes_info, vm, tuple_id, next_mask):
+        # struct <table>_value_mask { __u32 tuple_id; <table>_key_mask next_tuple_mask; __u8 has_next; }
+        v = bytearray(prefixes_info.value_size)
+        v[vm["tuple_id"]:vm["tuple_id"] + 4] = pack(tuple_id, 4)
+        if next_mask is not None:
+            v[vm["next_tuple_mask"]:vm["next_tuple_mask"] + prefixes_info.key_size] = next_mask
+            v[vm["has_next"]] = 1
+        return bytes(v)
+
+    def load_ternary(self, entries):
+        prefixes_fd = bpfsys.obj_get(self.path("prefixes"))
+        tuples_fd = bpfsys.obj_get(self.path("tuples_map"))
+        try:
+            tuples_info = bpfsys.map_info(tuples_fd)
+            prefixes_info = bpfsys.map_info(prefixes_fd)
+            vm = {m[0]: m[1] for m in self.btf.members(prefixes_info.btf_value_type_id)}
+            by_mask = self.group_by_mask(entries, prefixes_info.key_size)
+            existing, tail, tail_node = self.walk(prefixes_fd, prefixes_info, vm)
+            used_ids = set(existing.values())
+
+            batched = True
+            new_masks = []
+            for mask, items in by_mask.items():
+                if mask in existing:
+                    inner_id = int.from_bytes(bpfsys.map_lookup(tuples_fd, pack(existing[mask], 4), 4), sys.byteorder)
+                    inner_fd = bpfsys.map_fd_by_id(inner_id)
+                    try:
+                        batched &= bpfsys.map_update_batch(inner_fd, [k for k, _ in items], [v for _, v in items])
+                    finally:
+                        os.close(inner_fd)
+                    continue
+                tuple_id = next(i for i in range(tuples_info.max_entries) if i not in used_ids)
+                used_ids.add(tuple_id)
+                batched &= self.add_tuple(tuples_fd, tuple_id, items)
+                new_masks.append((mask, tuple_id))
+
+            # link new tuples after the current tail, the tail is updated last
+            for i in reversed(range(len(new_masks))):
+                mask, tuple_id = new_masks[i]
+                bpfsys.map_update(prefixes_fd, mask, self.value_mask(
+                    prefixes_info, vm, tuple_id, new_masks[i + 1][0] if i + 1 < len(new_masks) else None))
+            if new_masks:
+                tail_id = 0 if tail_node is None else int.from_bytes(tail_node[vm["tuple_id"]:vm["tuple_id"] + 4],
+                                                                     sys.byteorder)
+                bpfsys.map_update(prefixes_fd, tail, self.value_mask(prefixes_info, vm, tail_id, new_masks[0][0]))
+            return batched
+        finally:
+            os.close(prefixes_fd)
+            os.close(tuples_fd)
+
+    def load_shadow(self, entries):
+        # The entries replace the whole table: a new list of tuples is built aside and
+        # published by swapping the only slot of <table>_prefixes_set.
+        set_fd = bpfsys.obj_get(self.path("prefixes_set"))
+        tuples_fd = bpfsys.obj_get(self.path("tuples_map"))
+        template_fd = bpfsys.obj_get(self.path("prefixes_inner"))
+        old_fd, new_fd = None, None
+        try:
+            tuples_info = bpfsys.map_info(tuples_fd)
+            prefixes_info = bpfsys.map_info(template_fd)
+            vm = {m[0]: m[1] for m in self.btf.members(prefixes_info.btf_value_type_id)}
+            by_mask = self.group_by_mask(entries, prefixes_info.key_size)
+
+            # tuples of the active instance stay untouched until the swap
+            old_ids = []
+            old_id = bpfsys.map_lookup(set_fd, pack(0, 4), 4)
+            if old_id is not None:
+                old_fd = bpfsys.map_fd_by_id(int.from_bytes(old_id, sys.byteorder))
+                old_ids = list(self.walk(old_fd, prefixes_info, vm)[0].values())
+            free_ids = (i for i in range(tuples_info.max_entries) if i not in old_ids)
+
+            batched = True
+            masks = []
+            for mask, items in by_mask.items():
+                tuple_id = next(free_ids)
+                batched &= self.add_tuple(tuples_fd, tuple_id, items)
+                masks.append((mask, tuple_id))
+
+            new_fd = bpfsys.map_create(bpfsys.BPF_MAP_TYPE_HASH, prefixes_info.key_size, prefixes_info.value_size,
+                                       prefixes_info.max_entries, prefixes_info.map_flags)
+            bpfsys.map_update(new_fd, bytes(prefixes_info.key_size),
+                              self.value_mask(prefixes_info, vm, 0, masks[0][0] if masks else None))
+            for i, (mask, tuple_id) in enumerate(masks):
+                bpfsys.map_update(new_fd, mask, self.value_mask(
+                    prefixes_info, vm, tuple_id, masks[i + 1][0] if i + 1 < len(masks) else None))
+
+            bpfsys.map_update(set_fd, pack(0, 4), pack(new_fd, 4))
+
+            # packets in flight may still walk the old list, release its tuples once they are done
+            time.sleep(SHADOW_GRACE_PERIOD)
+            for tuple_id in old_ids:
+                bpfsys.map_delete(tuples_fd, pack(tuple_id, 4))
+            return batched
+        finally:
+            for fd in (set_fd, tuples_fd, template_fd, old_fd, new_fd):
+                if fd is not None:
+                    os.close(fd)
+
+    def tuple_size(self):
+        # the inner map template if pinned by the loader, otherwise the list of masks,
+        # which the compiler sizes like the tuples (the table size)
+        for suffix in ("tuple", "prefixes_inner", "prefixes"):
+            if os.path.exists(self.path(suffix)):
+                fd = bpfsys.obj_get(self.path(suffix))
+                try:
+                    return bpfsys.map_info(fd).max_entries
+                finally:
+                    os.close(fd)
+        raise FileNotFoundError("{}: no tuple or prefixes map".format(self.name))
+
+
+def flush(pending, final=False):
+    # install the packed entries of every table, in the order the tables were seen;
+    # a table with shadow instances is replaced as a whole, so it is written once at the end
+    # (psabpf-ctl cannot write it, the lines run in between do not depend on it)
+    for name, (table, entries, start, pack_time) in list(pending.items()):
+        if table.shadow and not final:
+            continue
+        del pending[name]
+        packed = time.time()
+        batched = table.load(entries)
+        end = time.time()
+        print("{}: {} entries in {:.3f} s ({:.0f} entries/s; pack {:.3f} s, {} {:.3f} s)".format(
+            table.name, len(entries), end - start, len(entries) / max(end - start, 1e-9),
+            pack_time, "batch update" if batched else "update", end - packed))
+        if table.ternary and os.path.exists(table.path("tuples_sorted")):
+            subprocess.check_call([sys.executable, os.path.join(os.path.dirname(__file__), "ternary_reorder.py"),
+                                   "--pipe", name[0], table.name])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Bulk loader for PSA-eBPF tables")
+    parser.add_argument("entries", nargs="?", help="file with psabpf-ctl arguments (default: stdin)")
+    args = parser.parse_args()
+
+    ret = 0
+    tables = {}
+    # (pipe, table) -> [Table, packed entries, time of the first entry, time spent packing]
+    pending = collections.OrderedDict()
+    with open(args.entries) if args.entries else sys.stdin as f:
+        for line in f:
+            argv = line.split()
+            if not argv:
+                continue
+            if argv[:3] == ["table", "add", "pipe"]:
+                name = (argv[3], argv[4])
+                start = time.time()
+                if name not in tables:
+                    try:
+                        tables[name] = Table("/sys/fs/bpf/pipeline{}/maps".format(argv[3]), argv[4])
+                    except Unsupported:
+                        tables[name] = None
+                table = tables[name]
+                try:
+                    if table is None:
+                        raise Unsupported(argv[4])
+                    entry = table.pack_entry(argv[5:])
+                except Unsupported:
+                    pass
+                else:
+                    batch = pending.setdefault(name, [table, [], start, 0])
+                    batch[1].append(entry)
+                    batch[3] += time.time() - start
+                    continue
+            # everything else goes to psabpf-ctl after the entries read so far
+            flush(pending)
+            if subprocess.call(["psabpf-ctl"] + argv) != 0:
+                ret = 1
+    flush(pending, final=True)
+    return ret
+
+
+if __name__ == "__main__":
+    sys.exit(main())
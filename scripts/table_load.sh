@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# Run a runtime_cmd file with 'psabpf-ctl table add' entries installed in bulk by
+# scripts/table_load.py. All other psabpf-ctl commands run as usual; the captured entries
+# are installed after the file has been run.
+#
+# Usage: sudo -E ./scripts/table_load.sh RUNTIME_CMD_FILE
+
+if [[ $# -ne 1 ]]; then
+  echo "Usage: $0 RUNTIME_CMD_FILE"
+  exit 1
+fi
+
+TABLE_LOAD_ENTRIES=$(mktemp)
+export TABLE_LOAD_ENTRIES
+
+function psabpf-ctl() {
+  if [[ "$1" == "table" && "$2" == "add" && "$3" == "pipe" ]]; then
+    echo "$*" >> "$TABLE_LOAD_ENTRIES"
+  else
+    command psabpf-ctl "$@"
+  fi
+}
+export -f psabpf-ctl
+
+bash "$1"
+ret=$?
+python3 "$(dirname "$0")/table_load.py" "$TABLE_LOAD_ENTRIES" || ret=1
+rm -f "$TABLE_LOAD_ENTRIES"
+exit $ret
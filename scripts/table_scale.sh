@@ -0,0 +1,88 @@
+#!/bin/bash
+#
+# Lookup cost of the 04_tables programs (figure 4) at full-FIB scale, without NICs.
+#
+# Usage: sudo -E ./scripts/table_scale.sh [-k "exact lpm ternary"] [-n "1000 10000 100000 1000000"] \
+#            [-d DURATION] [-o RESULTS] [-s]
+#
+# For every match kind and table size, p4testdata/04_tables/<kind>.p4 is compiled with the
+# table size set to the number of entries and loaded as pipeline 99 (no ports are attached).
+# Entries generated by scripts/gen_table.py are installed with scripts/table_load.py (or with one
+# psabpf-ctl call per entry with -s), then packets hitting
+# the entries are fed to xdp_ingress_func with BPF_PROG_TEST_RUN while 'bpftool prog profile'
+# counts cycles (scripts/test_run_lib.sh). p4testdata/04_tables/baseline.p4 is measured first,
+# so that the lookup cost is the difference to the baseline.
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+KINDS="exact lpm ternary"
+SIZES="1000 10000 100000 1000000"
+DURATION=10
+RESULTS=table_scale.txt
+P4ARGS="--xdp --pipeline-opt --hdr2Map --max-ternary-masks 11"
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -k) KINDS="$2"; shift; shift ;;
+    -n) SIZES="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -s) PER_ENTRY=1; shift ;;
+    *) echo "Unknown option $1"; exit 1 ;;
+  esac
+done
+
+if [[ -z "$P4C_REPO" ]]; then
+  echo "P4C_REPO is not set"
+  exit 1
+fi
+
+WORKDIR=$(mktemp -d)
+source scripts/test_run_lib.sh
+
+# Load the program compiled from $1 with table size $2
+function load_pipeline() {
+  local obj
+  sed "s/size = [0-9]*;/size = $2;/" "$1" > "$WORKDIR/prog.p4"
+  obj="$(test_run_build "$WORKDIR/prog.p4" "")" || return 1
+  test_run_load "$obj"
+}
+
+# Run test packets from $1 through xdp_ingress_func, print: <run_cnt> <cycles> <cycles/pkt> <ns/pkt>
+function measure() {
+  test_run_measure xdp_ingress_fun --packets "$1" --repeat 1000 | awk '{print $1, $2, $3, $4}'
+}
+
+test_run_init
+
+echo "# kind entries install_s run_cnt cycles cycles_per_packet ns_per_packet" > "$RESULTS"
+
+python3 scripts/gen_table.py --addresses "$WORKDIR/addresses" exact 1000 > /dev/null
+python3 scripts/test_packets.py "$WORKDIR/addresses" "$WORKDIR/packets"
+load_pipeline p4testdata/04_tables/baseline.p4 1000 || exit 1
+echo "baseline 0 0 $(measure "$WORKDIR/packets")" | tee -a "$RESULTS"
+
+for kind in $KINDS; do
+  for size in $SIZES; do
+    python3 scripts/gen_table.py --addresses "$WORKDIR/addresses" "$kind" "$size" > "$WORKDIR/entries"
+    rm -rf "$WORKDIR/packets"
+    python3 scripts/test_packets.py "$WORKDIR/addresses" "$WORKDIR/packets"
+    load_pipeline "p4testdata/04_tables/$kind.p4" "$size" || exit 1
+
+    START=$(date +%s.%N)
+    if [[ -n "$PER_ENTRY" ]]; then
+      while read -r key port prio; do
+        psabpf-ctl table add pipe 99 ingress_tbl_fwd id 1 key "$key" data "$port" ${prio:+priority $prio}
+      done < "$WORKDIR/entries"
+    else
+      awk '{printf "table add pipe 99 ingress_tbl_fwd id 1 key %s data %s%s\n", $1, $2, NF > 2 ? " priority " $3 : ""}' \
+          "$WORKDIR/entries" | python3 scripts/table_load.py > /dev/null || exit 1
+    fi
+    INSTALL=$(awk -v start="$START" -v end="$(date +%s.%N)" 'BEGIN {printf "%.2f", end - start}')
+
+    echo "$kind $size $INSTALL $(measure "$WORKDIR/packets")" | tee -a "$RESULTS"
+  done
+done
+
+test_run_unload
+rm -rf "$WORKDIR"
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+#
+# Fill the tail call map of a pipeline split into stages (see
+# p4testdata/01_use_cases/cycles/bng/tail-calls) and report the size of its programs.
+#
+# Usage:
+#   sudo python3 scripts/tail_call_stages.py [--pipe 99] [--map ingress_stages] [PROGRAM...]
+#   sudo python3 scripts/tail_call_stages.py [--pipe 99] --stats
+#
+# PROGRAMs (names as shown by 'bpftool prog', default: xdp_ingress_fwd xdp_ingress_bng) are put
+# in slots 1, 2, ... of the BPF_MAP_TYPE_PROG_ARRAY pinned as MAP; slot 0 is the entry program
+# attached to the interfaces. Only programs of the pipeline (pinned by the loader or using its
+# maps) are taken. Run it once after the pipeline is loaded; the map keeps the programs as long as it
+# is pinned.
+# With --stats, prints one line per program of the pipeline:
+# <name> <xlated instructions> <instructions processed by the verifier>
+
+import argparse
+import os
+import struct
+import sys
+
+import bpfsys
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fill the tail call map of a staged pipeline")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("--map", default="ingress_stages", help="pinned BPF_MAP_TYPE_PROG_ARRAY (default ingress_stages)")
+    parser.add_argument("--stats", action="store_true", help="print instruction counts of the pipeline programs")
+    parser.add_argument("programs", nargs="*", default=["xdp_ingress_fwd", "xdp_ingress_bng"],
+                        help="programs of slots 1, 2, ...")
+    args = parser.parse_args()
+
+    progs = bpfsys.pipeline_progs(args.pipe)
+    if args.stats:
+        for name, (prog_id, info) in sorted(progs.items()):
+            print(name, info.xlated_prog_len // 8, info.verified_insns)
+        return
+
+    map_fd = bpfsys.obj_get("/sys/fs/bpf/pipeline{}/maps/{}".format(args.pipe, args.map))
+    if bpfsys.map_info(map_fd).type != bpfsys.BPF_MAP_TYPE_PROG_ARRAY:
+        sys.exit("{} is not a BPF_MAP_TYPE_PROG_ARRAY".format(args.map))
+    for slot, name in enumerate(args.programs, start=1):
+        # bpftool and the kernel truncate program names to 15 characters
+        if name[:15] not in progs:
+            sys.exit("program {} of pipeline {} not found".format(name, args.pipe))
+        prog_fd = bpfsys.prog_fd_by_id(progs[name[:15]][0])
+        try:
+            bpfsys.map_update(map_fd, struct.pack("=I", slot), struct.pack("=I", prog_fd))
+        finally:
+            os.close(prog_fd)
+        print("{}[{}] = {}".format(args.map, slot, name))
+    os.close(map_fd)
+
+
+if __name__ == "__main__":
+    main()
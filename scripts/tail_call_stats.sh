@@ -0,0 +1,78 @@
+#!/bin/bash
+#
+# Verifier load time, instruction count and cycles per packet of monolithic and tail call
+# staged builds of a generated PSA-eBPF ingress, without NICs.
+#
+# Usage: sudo -E ./scripts/tail_call_stats.sh [-d DURATION] [-o RESULTS] [-c COMMANDS] NAME:PROGRAM[:CFLAGS]...
+# Example: sudo -E ./scripts/tail_call_stats.sh -o tail_calls.txt \
+#              monolithic:p4testdata/01_use_cases/cycles/bng/xdp/bng-ig-control.c \
+#              tail-calls:p4testdata/01_use_cases/cycles/bng/tail-calls/bng-ig-control.c
+#
+# Every PROGRAM is compiled with kernel.mk (and CFLAGS) and loaded as pipeline 99 a few times;
+# the load time is the median time of 'psabpf-ctl pipeline load' (dominated by the verifier).
+# Instructions (xlated and processed by the verifier) are summed over all xdp_ingress* programs.
+# Cycles per packet are counted by scripts/prog_cycles.sh, after scripts/tail_call_stages.py has
+# filled the tail call map (a no-op for monolithic builds) and COMMANDS have been run.
+# RESULTS gets one line per program:
+# <name> <load ms> <xlated insns> <verified insns> <largest verified insns of one program> <cycles per packet> <ns per packet>
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+DURATION=10
+RESULTS=tail_call_stats.txt
+LOADS=5
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -c) COMMANDS="$2"; shift; shift ;;
+    -*) echo "Unknown option $1"; exit 1 ;;
+    *) break ;;
+  esac
+done
+
+if [[ $# -eq 0 || -z "$P4C_REPO" ]]; then
+  echo "Usage: $0 [-d DURATION] [-o RESULTS] [-c COMMANDS] NAME:PROGRAM[:CFLAGS]..."
+  echo "P4C_REPO must be set"
+  exit 1
+fi
+
+WORKDIR=$(mktemp -d)
+
+function unload() {
+  psabpf-ctl pipeline unload id 99 2> /dev/null
+  rm -rf /sys/fs/bpf/pipeline99
+}
+
+# COMMANDS for prog_cycles.sh: fill the tail call map first
+cat > "$WORKDIR/commands" << EOF
+if [ -e /sys/fs/bpf/pipeline99/maps/ingress_stages ]; then
+  python3 scripts/tail_call_stages.py --pipe 99 || exit 1
+fi
+${COMMANDS:+bash "$COMMANDS"}
+EOF
+
+echo "# name load_ms xlated_insns verified_insns max_verified_insns cycles_per_packet ns_per_packet" > "$RESULTS"
+for arg in "$@"; do
+  IFS=: read -r NAME PROGRAM CFLAGS <<< "$arg"
+  unload
+  make -f $P4C_REPO/backends/ebpf/runtime/kernel.mk BPFOBJ=out.o \
+      ARGS="-DPSA_PORT_RECIRCULATE=2 $CFLAGS" ebpf CFILE="$PROGRAM" > /dev/null || exit 1
+  for i in $(seq $LOADS); do
+    unload
+    START=$(date +%s%N)
+    psabpf-ctl pipeline load id 99 out.o || exit 1
+    echo $(( ($(date +%s%N) - START) / 1000000 ))
+  done | sort -n > "$WORKDIR/loads"
+  LOAD_MS="$(awk '{v[NR] = $1} END {print v[int((NR + 1) / 2)]}' "$WORKDIR/loads")"
+  INSNS="$(python3 scripts/tail_call_stages.py --pipe 99 --stats | \
+      awk '$1 ~ /^xdp_ingress/ {x += $2; v += $3; if ($3 > m) m = $3} END {print x + 0, v + 0, m + 0}')"
+  unload
+
+  bash scripts/prog_cycles.sh -d "$DURATION" -o "$WORKDIR/cycles" -c "$WORKDIR/commands" "$arg" > /dev/null || exit 1
+  CYCLES="$(awk '!/^#/ {print $4, $5}' "$WORKDIR/cycles")"
+  echo "$NAME $LOAD_MS $INSNS $CYCLES" | tee -a "$RESULTS"
+done
+
+rm -rf "$WORKDIR"
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#
+# Install entries of the ternary table ingress_tbl_fwd into the bit-vector classifier
+# (see p4testdata/04_tables/bitvector/ternary-control.c).
+#
+# Usage:
+#   sudo python3 scripts/ternary_bv.py [--pipe 99] [RULES-FILE]
+#
+# Every line of RULES-FILE (or stdin) is one entry in the format used by psabpf-ctl:
+#   <VALUE>^<MASK> <EGRESS-PORT> [PRIORITY]
+# e.g. "48.1.0.0^0xffff0000 5". VALUE is an IPv4 address or an integer.
+# Entries with higher PRIORITY win; entries with equal priority keep the file order.
+# The whole classifier is rebuilt from the given entries and written with one
+# 'bpftool batch' call.
+
+import argparse
+import ipaddress
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+LEVELS = 4
+STRIDE = 8
+WORDS = 16
+MAX_RULES = WORDS * 64
+ACT_DO_FORWARD = 1
+
+
+def parse_int(s):
+    if "." in s:
+        return int(ipaddress.IPv4Address(s))
+    return int(s, 0)
+
+
+def parse_rules(lines):
+    rules = []
+    for line in lines:
+        line = line.split("#")[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        value, mask = fields[0].split("^") if "^" in fields[0] else (fields[0], "0xffffffff")
+        mask = parse_int(mask)
+        priority = int(fields[2], 0) if len(fields) > 2 else 0
+        rules.append((priority, parse_int(value) & mask, mask, int(fields[1], 0)))
+    # stable sort: higher priority first, file order for equal priority
+    rules.sort(key=lambda r: -r[0])
+    return rules
+
+
+def build_bit_vectors(rules):
+    vectors = []
+    for level in range(LEVELS):
+        shift = 32 - STRIDE * (level + 1)
+        for chunk in range(1 << STRIDE):
+            bits = 0
+            for idx, (_, value, mask, _) in enumerate(rules):
+                chunk_mask = (mask >> shift) & 0xff
+                if (chunk & chunk_mask) == ((value >> shift) & chunk_mask):
+                    bits |= 1 << idx
+            vectors.append(bits)
+    return vectors
+
+
+def u32_bytes(v):
+    return " ".join(str(b) for b in v.to_bytes(4, sys.byteorder))
+
+
+def bits_bytes(bits):
+    return " ".join(str(b) for w in range(WORDS)
+                    for b in ((bits >> (64 * w)) & (2 ** 64 - 1)).to_bytes(8, sys.byteorder))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Bit-vector classifier loader for ingress_tbl_fwd")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("rules", nargs="?", help="file with entries (default: stdin)")
+    args = parser.parse_args()
+
+    with open(args.rules) if args.rules else sys.stdin as f:
+        rules = parse_rules(f)
+    if len(rules) > MAX_RULES:
+        print("Too many entries: {} (max {})".format(len(rules), MAX_RULES), file=sys.stderr)
+        return 1
+
+    start = time.time()
+    maps_dir = "/sys/fs/bpf/pipeline{}/maps".format(args.pipe)
+    bv_map = os.path.join(maps_dir, "ingress_tbl_fwd_bv")
+    actions_map = os.path.join(maps_dir, "ingress_tbl_fwd_bv_actions")
+    words_map = os.path.join(maps_dir, "ingress_tbl_fwd_bv_words")
+
+    with tempfile.NamedTemporaryFile("w", suffix=".batch") as batch:
+        for idx, (_, _, _, port) in enumerate(rules):
+            # struct ingress_tbl_fwd_value { unsigned int action; u32 egress_port; }
+            batch.write("map update pinned {} key {} value {} {}\n".format(
+                actions_map, u32_bytes(idx), u32_bytes(ACT_DO_FORWARD), u32_bytes(port)))
+        for idx, bits in enumerate(build_bit_vectors(rules)):
+            batch.write("map update pinned {} key {} value {}\n".format(bv_map, u32_bytes(idx), bits_bytes(bits)))
+        batch.write("map update pinned {} key {} value {}\n".format(
+            words_map, u32_bytes(0), u32_bytes((len(rules) + 63) // 64)))
+        batch.flush()
+        subprocess.check_call(["bpftool", "batch", "file", batch.name], stdout=subprocess.DEVNULL)
+
+    print("Installed {} entries ({} words) in {:.2f} s".format(
+        len(rules), (len(rules) + 63) // 64, time.time() - start))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,43 @@
+#!/bin/bash
+#
+# Measure cycles per packet of the ternary table (figure 4) with 1000 entries spread
+# over 1..11 masks, for the tuple space search generated by p4c-ebpf and for
+# the bit-vector classifier (p4testdata/04_tables/bitvector).
+#
+# Usage: sudo -E ./scripts/ternary_masks.sh -E <ENV-FILE> -C <CORES> [-d DURATION] [-m "1 2 ... 11"] [-o RESULTS]
+#
+# For each run, start the generator once asked, as for figure 4 (see README, section 04).
+
+DURATION=30
+MASKS="1 2 3 4 5 6 7 8 9 10 11"
+RESULTS=ternary_masks.txt
+P4ARGS="--xdp --pipeline-opt --hdr2Map --max-ternary-masks 11"
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -E) ENV_FILE="$2"; shift; shift ;;
+    -C) CORES="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -m) MASKS="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    *) echo "Unknown option $1"; exit 1 ;;
+  esac
+done
+
+if [[ -z "$ENV_FILE" || -z "$CORES" ]]; then
+  echo "Usage: $0 -E <ENV-FILE> -C <CORES> [-d DURATION] [-m \"1 2 ... 11\"] [-o RESULTS]"
+  exit 1
+fi
+
+echo "# backend masks run_cnt cycles cycles_per_packet" > "$RESULTS"
+for masks in $MASKS; do
+  ./setup_test.sh -C "$CORES" --target psa-ebpf --p4args "$P4ARGS" -E "$ENV_FILE" \
+    -c "runtime_cmd/04_tables/ternary-masks/1000-entries-$masks-masks" p4testdata/04_tables/ternary.p4 > /dev/null
+  read -p "[tuple space, $masks masks] Start traffic on the generator and press Enter.."
+  echo "tss $masks $(bash scripts/prog_profile.sh "$DURATION" xdp_ingress_fun | awk '{print $2, $3, $4}')" | tee -a "$RESULTS"
+
+  ./setup_test.sh -C "$CORES" --target psa-ebpf -E "$ENV_FILE" \
+    -c "runtime_cmd/04_tables/bitvector/1000-entries-$masks-masks" p4testdata/04_tables/bitvector/ternary-control.c > /dev/null
+  read -p "[bit vector, $masks masks] Start traffic on the generator and press Enter.."
+  echo "bitvector $masks $(bash scripts/prog_profile.sh "$DURATION" xdp_ingress_fun | awk '{print $2, $3, $4}')" | tee -a "$RESULTS"
+done
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# Order the tuples of a ternary table by descending priority, so that the data path
+# can stop the tuple walk early (see p4testdata/01_use_cases/cycles/upf/tuple-priority).
+#
+# Usage:
+#   sudo python3 scripts/ternary_reorder.py [--pipe 99] TABLE [TABLE...]
+#
+# For every tuple the highest entry priority is written to <TABLE>_tuples_prio. The linked
+# list of masks is copied in descending priority order to a new map, which replaces the only
+# slot of <TABLE>_prefixes_sorted in one update (the data path walks either the old or the new
+# list, never a half rewritten one) and is pinned as <TABLE>_prefixes, so that later table
+# writes go to the list being walked. Then <TABLE>_tuples_sorted is set. Run it again after
+# every table write (scripts/table_ctl.sh does it automatically). Table writes must not run
+# at the same time as the reorder, they would go to the list being replaced.
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+import bpfsys
+from table_load import BTF
+
+
+def max_priorities(maps_dir, table, btf):
+    """Highest entry priority of every tuple, read from the tuple maps."""
+    value_type = btf.find_struct(table + "_value")
+    _, prio_offset, _, _ = [m for m in btf.members(value_type) if m[0] == "priority"][0]
+    priorities = {}
+    fd = bpfsys.obj_get(os.path.join(maps_dir, table + "_tuples_map"))
+    try:
+        for key in bpfsys.map_keys(fd, 4):
+            inner_id = bpfsys.map_lookup(fd, key, 4)
+            if inner_id is None:
+                continue
+            inner_fd = bpfsys.map_fd_by_id(struct.unpack("=I", inner_id)[0])
+            try:
+                info = bpfsys.map_info(inner_fd)
+                priorities[struct.unpack("=I", key)[0]] = max(
+                    (struct.unpack_from("=I", bpfsys.map_lookup(inner_fd, k, info.value_size), prio_offset)[0]
+                     for k in bpfsys.map_keys(inner_fd, info.key_size)), default=0)
+            finally:
+                os.close(inner_fd)
+    finally:
+        os.close(fd)
+    return priorities
+
+
+def reorder(maps_dir, table):
+    path = os.path.join(maps_dir, table + "_prefixes")
+    fd = bpfsys.obj_get(path)
+    try:
+        info = bpfsys.map_info(fd)
+        entries = [(k, bpfsys.map_lookup(fd, k, info.value_size)) for k in bpfsys.map_keys(fd, info.key_size)]
+    finally:
+        os.close(fd)
+    # struct <table>_value_mask { __u32 tuple_id; struct <table>_key_mask next_tuple_mask; __u8 has_next; }
+    btf = BTF(info.btf_id)
+    layout = {m[0]: m[1] for m in btf.members(info.btf_value_type_id)}
+    tuple_offset, next_offset, has_next_offset = layout["tuple_id"], layout["next_tuple_mask"], layout["has_next"]
+    priorities = max_priorities(maps_dir, table, btf)
+
+    head = None
+    tuples = []
+    for key, value in entries:
+        if value is None:
+            continue
+        if not any(key):
+            head = (key, bytearray(value))
+        else:
+            tuple_id = struct.unpack_from("=I", value, tuple_offset)[0]
+            tuples.append((priorities.get(tuple_id, 0), tuple_id, key, bytearray(value)))
+    if head is None:
+        return 0
+    tuples.sort(key=lambda t: -t[0])
+
+    prio_fd = bpfsys.obj_get(os.path.join(maps_dir, table + "_tuples_prio"))
+    try:
+        # before the switch, so that no tuple of the new list is walked without its priority
+        for priority, tuple_id, _, _ in tuples:
+            bpfsys.map_update(prio_fd, struct.pack("=I", tuple_id), struct.pack("=I", priority))
+
+        nodes = [head] + [(key, value) for _, _, key, value in tuples]
+        keys, values = [], []
+        for i, (key, value) in enumerate(nodes):
+            next_key = nodes[i + 1][0] if i + 1 < len(nodes) else bytes(info.key_size)
+            value[next_offset:next_offset + info.key_size] = next_key
+            value[has_next_offset] = 1 if i + 1 < len(nodes) else 0
+            keys.append(key)
+            values.append(bytes(value))
+
+        btf_fd = bpfsys.btf_fd_by_id(info.btf_id)
+        try:
+            new_fd = bpfsys.map_create(info.type, info.key_size, info.value_size, info.max_entries, info.map_flags,
+                                       info.name, (btf_fd, info.btf_key_type_id, info.btf_value_type_id))
+        finally:
+            os.close(btf_fd)
+        try:
+            bpfsys.map_update_batch(new_fd, keys, values)
+            sorted_fd = bpfsys.obj_get(os.path.join(maps_dir, table + "_prefixes_sorted"))
+            try:
+                bpfsys.map_update(sorted_fd, struct.pack("=I", 0), struct.pack("=I", new_fd))
+            finally:
+                os.close(sorted_fd)
+            # replaces the pin of the previous list in one step
+            if os.path.exists(path + ".new"):
+                os.unlink(path + ".new")
+            bpfsys.obj_pin(new_fd, path + ".new")
+            os.rename(path + ".new", path)
+        finally:
+            os.close(new_fd)
+
+        sorted_flag = bpfsys.obj_get(os.path.join(maps_dir, table + "_tuples_sorted"))
+        try:
+            bpfsys.map_update(sorted_flag, struct.pack("=I", 0), struct.pack("=I", 1))
+        finally:
+            os.close(sorted_flag)
+
+        # tuples that no longer exist
+        current = {struct.pack("=I", tuple_id) for _, tuple_id, _, _ in tuples}
+        for key in [k for k in bpfsys.map_keys(prio_fd, 4) if k not in current]:
+            bpfsys.map_delete(prio_fd, key)
+    finally:
+        os.close(prio_fd)
+    return len(tuples)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Order ternary table tuples by priority")
+    parser.add_argument("--pipe", default="99", help="pipeline ID (default 99)")
+    parser.add_argument("tables", nargs="+", help="ternary table names")
+    args = parser.parse_args()
+
+    maps_dir = "/sys/fs/bpf/pipeline{}/maps".format(args.pipe)
+    for table in args.tables:
+        if not os.path.exists(os.path.join(maps_dir, table + "_prefixes_sorted")):
+            print("{}: no {}_prefixes_sorted map, skipping".format(table, table), file=sys.stderr)
+            continue
+        start = time.time()
+        count = reorder(maps_dir, table)
+        print("{}: ordered {} tuples in {:.2f} s".format(table, count, time.time() - start))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
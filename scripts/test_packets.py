@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+#
+# Write raw Ethernet/IPv4/UDP frames to be used as input of BPF_PROG_TEST_RUN
+# ('bpftool prog run ... data_in FILE').
+#
+# Usage:
+#   python3 scripts/test_packets.py [--count 64] [--size 64] [--seed 1] ADDRESSES-FILE OUTPUT-DIR
+#
+# ADDRESSES-FILE holds one IPv4 destination address per line (e.g. written by
+# scripts/gen_table.py --addresses); COUNT of them are sampled and written to
+# OUTPUT-DIR/pkt-<n>.bin.
+
+import argparse
+import ipaddress
+import os
+import random
+import struct
+import sys
+
+
+def checksum(data):
+    s = sum(struct.unpack("!{}H".format(len(data) // 2), data))
+    s = (s >> 16) + (s & 0xffff)
+    s += s >> 16
+    return ~s & 0xffff
+
+
+def frame(dst, size):
+    payload_len = max(size - 14 - 20 - 8, 0)
+    udp = struct.pack("!HHHH", 1024, 1024, 8 + payload_len, 0) + bytes(payload_len)
+    ip = struct.pack("!BBHHHBBH4s4s", 0x45, 0, 20 + len(udp), 0, 0, 64, 17, 0,
+                     ipaddress.IPv4Address("10.0.0.1").packed, dst.packed)
+    ip = ip[:10] + struct.pack("!H", checksum(ip)) + ip[12:]
+    eth = bytes.fromhex("001122334455" "00aabbccddee" "0800")
+    return eth + ip + udp
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BPF_PROG_TEST_RUN packets generator")
+    parser.add_argument("--count", type=int, default=64, help="number of packets (default 64)")
+    parser.add_argument("--size", type=int, default=64, help="frame size without FCS (default 64)")
+    parser.add_argument("--seed", type=int, default=1, help="random seed (default 1)")
+    parser.add_argument("addresses", help="file with destination addresses")
+    parser.add_argument("output", help="output directory")
+    args = parser.parse_args()
+
+    with open(args.addresses) as f:
+        addrs = [ipaddress.IPv4Address(l.strip()) for l in f if l.strip()]
+    if not addrs:
+        print("No addresses in {}".format(args.addresses), file=sys.stderr)
+        return 1
+    rng = random.Random(args.seed)
+    os.makedirs(args.output, exist_ok=True)
+    for n in range(args.count):
+        with open(os.path.join(args.output, "pkt-{}.bin".format(n)), "wb") as f:
+            f.write(frame(rng.choice(addrs), args.size))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+#!/bin/bash
+#
+# Offline data path benchmark of PSA-eBPF pipelines: no NICs and no traffic generator needed.
+#
+# Usage: sudo -E ./scripts/test_run_bench.sh [-E ENV-FILE] [-d DURATION] [-o RESULTS] [-c COMMANDS]
+#            [-p P4ARGS] [-r REPEAT] [-l BATCH_SIZE] [-P PROGRAMS] [-f PCAP | -a ADDRESSES [-s SIZE]]
+#            NAME:PROGRAM[:CFLAGS] | DIRECTORY ...
+# Example: sudo -E ./scripts/test_run_bench.sh -o l2l3.txt -c runtime_cmd/01_use_cases/l2l3_acl_routing.txt \
+#              -a addresses.txt l2l3:p4testdata/01_use_cases/l2l3_acl.p4
+#          sudo -E ./scripts/test_run_bench.sh -o cycles.txt p4testdata/01_use_cases/cycles/l2fwd
+#
+# PROGRAM is an object built by kernel.mk (.o), a generated program (.c, compiled with CFLAGS) or
+# a P4 program (.p4, compiled with P4ARGS, default "--hdr2Map --max-ternary-masks 3 --xdp"). For
+# a DIRECTORY every .c file below it is benchmarked, named by its path relative to DIRECTORY.
+# Each program is loaded as pipeline 99 with two veth ports (psa_tr0, psa_tr1, whose peers are
+# psa_tr0p, psa_tr1p) and COMMANDS are run with PORT0_INDEX and PORT1_INDEX set to the ports
+# (other variables, e.g. DUT_MAC0, are taken from ENV-FILE). Then packets (PCAP, destination
+# ADDRESSES as in scripts/test_packets.py, by default 10.0.0.2) are replayed through every program
+# of PROGRAMS (default "xdp_ingress_fun tc_ingress_func") with BPF_PROG_TEST_RUN by
+# scripts/prog_test_run.py, while scripts/prog_profile.sh counts cycles (scripts/test_run_lib.sh).
+# With -l, XDP programs are run in live frames mode with BATCH_SIZE frames per batch.
+# RESULTS gets one line per pipeline and program:
+# <name> <program> <run_cnt> <cycles per packet> <ns per packet> <verdicts as retval:percent,...>
+# Verdicts are "-" in live frames mode, where the program returns what the kernel did with the frame.
+# Objects are built in a temporary directory; a PROGRAM object is loaded from where it is.
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+DURATION=10
+RESULTS=test_run_bench.txt
+P4ARGS="--hdr2Map --max-ternary-masks 3 --xdp"
+REPEAT=1000
+SIZE=64
+PROGRAMS="xdp_ingress_fun tc_ingress_func"
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -E) ENV_FILE="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -c) COMMANDS="$2"; shift; shift ;;
+    -p) P4ARGS="$2"; shift; shift ;;
+    -r) REPEAT="$2"; shift; shift ;;
+    -l) BATCH_SIZE="$2"; shift; shift ;;
+    -P) PROGRAMS="$2"; shift; shift ;;
+    -f) PCAP="$2"; shift; shift ;;
+    -a) ADDRESSES="$2"; shift; shift ;;
+    -s) SIZE="$2"; shift; shift ;;
+    -*) echo "Unknown option $1"; exit 1 ;;
+    *) break ;;
+  esac
+done
+
+if [[ $# -eq 0 || -z "$P4C_REPO" ]]; then
+  echo "Usage: $0 [-E ENV-FILE] [-d DURATION] [-o RESULTS] [-c COMMANDS] [-p P4ARGS] [-r REPEAT] [-l BATCH_SIZE]" \
+       "[-P PROGRAMS] [-f PCAP | -a ADDRESSES [-s SIZE]] NAME:PROGRAM[:CFLAGS] | DIRECTORY ..."
+  echo "P4C_REPO must be set"
+  exit 1
+fi
+
+WORKDIR=$(mktemp -d)
+source scripts/test_run_lib.sh
+
+function bench() {
+  local name="$1" program="$2" cflags="$3" obj result
+  test_run_unload
+  obj="$(test_run_build "$program" "$cflags")" || { echo "$name: build failed" >&2; return 1; }
+  test_run_load "$obj" || { echo "$name: load failed" >&2; return 1; }
+  for intf in psa_tr0 psa_tr1; do
+    psabpf-ctl pipeline add-port id 99 "$intf" > /dev/null
+  done
+  if [[ -n "$COMMANDS" ]]; then
+    bash "$COMMANDS" > /dev/null || { echo "$name: $COMMANDS failed" >&2; return 1; }
+  fi
+
+  for prog in $PROGRAMS; do
+    result="$(test_run_measure "$prog" --repeat "$REPEAT" ${BATCH_SIZE:+--live --batch-size "$BATCH_SIZE"} $SOURCE)" || continue
+    echo "$name $prog $(echo "$result" | awk '{print $1, $3, $4, $5}')" | tee -a "$RESULTS"
+  done
+}
+
+if [[ -n "$ENV_FILE" ]]; then
+  set -o allexport
+  source "$ENV_FILE"
+  set +o allexport
+fi
+
+test_run_init
+for i in 0 1; do
+  ip link add name psa_tr$i type veth peer name psa_tr${i}p 2> /dev/null
+  ip link set dev psa_tr$i up
+  ip link set dev psa_tr${i}p up
+done
+export PORT0_INDEX="$(cat /sys/class/net/psa_tr0/ifindex)"
+export PORT1_INDEX="$(cat /sys/class/net/psa_tr1/ifindex)"
+
+if [[ -n "$PCAP" ]]; then
+  SOURCE="--pcap $PCAP"
+else
+  if [[ -z "$ADDRESSES" ]]; then
+    ADDRESSES="$WORKDIR/addresses"
+    echo 10.0.0.2 > "$ADDRESSES"
+  fi
+  python3 scripts/test_packets.py --count 64 --size "$SIZE" "$ADDRESSES" "$WORKDIR/packets"
+  SOURCE="--packets $WORKDIR/packets"
+fi
+
+echo "# name program run_cnt cycles_per_packet ns_per_packet verdicts" > "$RESULTS"
+for arg in "$@"; do
+  if [[ -d "$arg" ]]; then
+    arg="${arg%/}"
+    while read -r program; do
+      name="${program#$arg/}"
+      bench "${name%.c}" "$program" ""
+    done < <(find "$arg" -name '*.c' | sort)
+  else
+    IFS=: read -r NAME PROGRAM CFLAGS <<< "$arg"
+    bench "$NAME" "$PROGRAM" "$CFLAGS"
+  fi
+done
+
+test_run_unload
+ip link del psa_tr0 2> /dev/null
+ip link del psa_tr1 2> /dev/null
+rm -rf "$WORKDIR"
@@ -0,0 +1,63 @@
+#!/bin/bash
+#
+# Shared part of the offline benchmarks (scripts/test_run_bench.sh, scripts/prog_cycles.sh and
+# scripts/table_scale.sh): build and load a pipeline as pipeline 99 and measure one of its
+# programs with BPF_PROG_TEST_RUN, without NICs or a traffic generator.
+#
+# Source it from the repository root after WORKDIR (a temporary directory) and DURATION are set.
+# Objects are built in $WORKDIR/build, so nothing is written to or deleted from the current
+# directory. Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+# Create the recirculation port and set RECIRC_PORT_ID
+function test_run_init() {
+  ip link add name psa_recirc type dummy 2> /dev/null
+  ip link set dev psa_recirc up
+  RECIRC_PORT_ID=$(ip -o link | awk '$2 == "psa_recirc:" {print $1}' | awk -F':' '{print $1}')
+}
+
+# Compile $1 with CFLAGS $2 and print the path of the object: an object built by kernel.mk (.o)
+# is used as is, a P4 program (.p4) is compiled with P4ARGS, a generated program (.c) directly.
+function test_run_build() {
+  local program="$1" cflags="$2" src
+  if [[ "$program" == *.o ]]; then
+    echo "$program"
+    return 0
+  fi
+  src="$(realpath "$program")" || return 1
+  rm -rf "$WORKDIR/build"
+  mkdir -p "$WORKDIR/build"
+  if [[ "$program" == *.p4 ]]; then
+    (cd "$WORKDIR/build" && make -f $P4C_REPO/backends/ebpf/runtime/kernel.mk BPFOBJ=out.o P4FILE="$src" \
+        ARGS="-DPSA_PORT_RECIRCULATE=$RECIRC_PORT_ID $cflags" P4ARGS="$P4ARGS" psa > /dev/null) || return 1
+  else
+    (cd "$WORKDIR/build" && make -f $P4C_REPO/backends/ebpf/runtime/kernel.mk BPFOBJ=out.o \
+        ARGS="-DPSA_PORT_RECIRCULATE=$RECIRC_PORT_ID $cflags" ebpf CFILE="$src" > /dev/null) || return 1
+  fi
+  echo "$WORKDIR/build/out.o"
+}
+
+function test_run_unload() {
+  psabpf-ctl pipeline unload id 99 2> /dev/null
+  rm -rf /sys/fs/bpf/pipeline99
+}
+
+# Load the object $1 as pipeline 99
+function test_run_load() {
+  test_run_unload
+  psabpf-ctl pipeline load id 99 "$1"
+}
+
+# Replay packets through program $1 of pipeline 99 with scripts/prog_test_run.py (the other
+# arguments are passed to it, e.g. --packets DIR --repeat N) for DURATION seconds, while
+# scripts/prog_profile.sh counts cycles. Prints:
+# <run_cnt> <cycles> <cycles per packet> <ns per packet> <verdicts as retval:percent,...>
+function test_run_measure() {
+  local prog="$1" profile_pid
+  shift
+  bash scripts/prog_profile.sh "$DURATION" "$prog" > "$WORKDIR/profile" &
+  profile_pid=$!
+  python3 scripts/prog_test_run.py --pipe 99 --duration "$DURATION" "$@" "$prog" > "$WORKDIR/test_run"
+  wait $profile_pid
+  [ -s "$WORKDIR/test_run" ] || return 1
+  echo "$(awk '{print $2, $3, $4}' "$WORKDIR/profile") $(awk '{print $3, $4}' "$WORKDIR/test_run")"
+}
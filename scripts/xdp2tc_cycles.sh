@@ -0,0 +1,54 @@
+#!/bin/bash
+#
+# Runtime cost of the XDP->TC metadata handoff modes of PSA-eBPF (default, cpumap, meta).
+#
+# Usage: sudo -E ./scripts/xdp2tc_cycles.sh -E <ENV-FILE> -C <CORES> [-d DURATION] [-o RESULTS] \
+#            [-p P4ARGS] [-m "default cpumap meta"] PROGRAM:COMMANDS [PROGRAM:COMMANDS...]
+#
+# Each P4 PROGRAM is deployed by setup_test.sh with P4ARGS (without --xdp, so that every packet is
+# handed from XDP to TC) and each handoff mode, then cycles per packet of xdp_ingress_func and
+# tc_ingress_func are counted with scripts/prog_profile.sh while the generator sends traffic.
+# RESULTS gets one line per program and mode:
+# <program> <mode> <xdp2tc_metadata size> <xdp cycles/pkt> <tc cycles/pkt> <total cycles/pkt>
+# and can be passed to scripts/xdp2tc_mode.sh -r (or setup_test.sh --xdp2tc-results).
+
+DURATION=30
+RESULTS=xdp2tc_cycles.txt
+P4ARGS="--hdr2Map --max-ternary-masks 3"
+MODES="default cpumap meta"
+
+POSITIONAL=()
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -E) ENV_FILE="$2"; shift; shift ;;
+    -C) CORES="$2"; shift; shift ;;
+    -d) DURATION="$2"; shift; shift ;;
+    -o) RESULTS="$2"; shift; shift ;;
+    -p) P4ARGS="$2"; shift; shift ;;
+    -m) MODES="$2"; shift; shift ;;
+    *) POSITIONAL+=("$1"); shift ;;
+  esac
+done
+
+if [[ -z "$ENV_FILE" || -z "$CORES" || ${#POSITIONAL[@]} -eq 0 ]]; then
+  echo "Usage: $0 -E <ENV-FILE> -C <CORES> [-d DURATION] [-o RESULTS] [-p P4ARGS] [-m MODES] PROGRAM:COMMANDS..."
+  exit 1
+fi
+
+echo "# program mode xdp2tc_metadata_size xdp_cycles_per_packet tc_cycles_per_packet total_cycles_per_packet" > "$RESULTS"
+for arg in "${POSITIONAL[@]}"; do
+  IFS=':' read -r program commands <<< "$arg"
+  for mode in $MODES; do
+    XDP2TC=""
+    [[ "$mode" != "default" ]] && XDP2TC="--xdp2tc=$mode"
+    ./setup_test.sh -C "$CORES" --target psa-ebpf -E "$ENV_FILE" -c "$commands" \
+        --p4args "$P4ARGS $XDP2TC" "$program" > /dev/null
+    SIZE="$(bpftool btf dump file out.o | awk '/ STRUCT .xdp2tc_metadata. size=/ {sub("size=", "", $4); print $4}')"
+    read -p "[$(basename "$program"), $mode] Start traffic on the generator and press Enter.."
+    RESULT="$(bash scripts/prog_profile.sh "$DURATION" xdp_ingress_fun tc_ingress_func)"
+    XDP="$(echo "$RESULT" | awk '$1 == "xdp_ingress_fun" {print $4}')"
+    TC="$(echo "$RESULT" | awk '$1 == "tc_ingress_func" {print $4}')"
+    echo "$(basename "$program") $mode ${SIZE:-0} ${XDP:-0} ${TC:-0}" \
+        "$(awk -v x="${XDP:-0}" -v t="${TC:-0}" 'BEGIN {printf "%.2f", x + t}')" | tee -a "$RESULTS"
+  done
+done
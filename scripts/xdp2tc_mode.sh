@@ -0,0 +1,89 @@
+#!/bin/bash
+#
+# Select the cheapest XDP->TC metadata handoff mode (--xdp2tc) of PSA-eBPF for a P4 program.
+#
+# Usage: scripts/xdp2tc_mode.sh [-p P4ARGS] [-m META_MAX] [-r RESULTS] PROGRAM [INTERFACE...]
+#
+# Prints the p4c-ebpf option to use: "--xdp2tc=meta", "--xdp2tc=cpumap" or nothing for the
+# default mode (metadata embedded in front of the packet). The reason is printed to stderr.
+# - meta is possible only if the drivers of all INTERFACEs fill data_meta on XDP receive and
+#   struct xdp2tc_metadata of PROGRAM (compiled with P4ARGS, size read from BTF) fits in
+#   META_MAX bytes (default 32, the most bpf_xdp_adjust_meta() accepts),
+# - with RESULTS written by scripts/xdp2tc_cycles.sh, the possible mode with the lowest
+#   measured XDP + TC cycles per packet of PROGRAM is chosen, even if it is not meta,
+# - without RESULTS (or without results of PROGRAM) meta is preferred over cpumap (no copy of
+#   the metadata) and cpumap over the default mode (no bpf_skb_load_bytes + bpf_skb_adjust_room
+#   per packet).
+#
+# Requires P4C_REPO to point to the p4c repository (as in the environment files).
+
+META_MAX=32
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    -p) P4ARGS="$2"; shift; shift ;;
+    -m) META_MAX="$2"; shift; shift ;;
+    -r) RESULTS="$2"; shift; shift ;;
+    -*) echo "Unknown option $1" >&2; exit 1 ;;
+    *) break ;;
+  esac
+done
+
+PROGRAM="$1"
+shift
+if [[ -z "$PROGRAM" || -z "$P4C_REPO" ]]; then
+  echo "Usage: $0 [-p P4ARGS] [-m META_MAX] [-r RESULTS] PROGRAM [INTERFACE...]" >&2
+  echo "P4C_REPO must be set" >&2
+  exit 1
+fi
+
+# Drivers that pass data_meta to XDP programs (xdp_prepare_buff(..., meta_valid = true))
+DATA_META_DRIVERS="i40e ice igb igc ixgbe ixgbevf mlx5_core nfp sfc stmmac tun veth virtio_net"
+
+function data_meta_supported() {
+  for intf in "$@"; do
+    driver="$(ethtool -i "$intf" 2> /dev/null | awk '$1 == "driver:" {print $2}')"
+    if [[ " $DATA_META_DRIVERS " != *" $driver "* ]]; then
+      echo "$intf: driver '${driver:-unknown}' does not support data_meta" >&2
+      return 1
+    fi
+  done
+  return 0
+}
+
+function xdp2tc_metadata_size() {
+  local workdir
+  # in its own directory, so that the out.o of a deployed program is not overwritten
+  workdir="$(mktemp -d)"
+  (cd "$workdir" && make -f $P4C_REPO/backends/ebpf/runtime/kernel.mk BPFOBJ=out.o P4FILE="$(realpath "$PROGRAM")" \
+      ARGS="-DPSA_PORT_RECIRCULATE=0" P4ARGS="$P4ARGS --xdp2tc=meta" psa > /dev/null 2>&1) && \
+    bpftool btf dump file "$workdir/out.o" | awk '/ STRUCT .xdp2tc_metadata. size=/ {sub("size=", "", $4); print $4}'
+  rm -rf "$workdir"
+}
+
+MODES="cpumap default"
+SIZE="$(xdp2tc_metadata_size)"
+if [[ -z "$SIZE" ]]; then
+  echo "$PROGRAM: size of struct xdp2tc_metadata unknown" >&2
+elif [[ "$SIZE" -gt "$META_MAX" ]]; then
+  echo "$PROGRAM: struct xdp2tc_metadata ($SIZE B) does not fit in data_meta ($META_MAX B)" >&2
+elif data_meta_supported "$@"; then
+  MODES="meta $MODES"
+fi
+
+MODE=""
+if [[ -n "$RESULTS" && -f "$RESULTS" ]]; then
+  # <program> <mode> <size> <xdp cycles/pkt> <tc cycles/pkt> <total cycles/pkt>
+  MODE="$(awk -v prog="$(basename "$PROGRAM")" -v modes=" $MODES " \
+      '$1 == prog && index(modes, " " $2 " ") && $6 > 0 && (best == "" || $6 < min) {best = $2; min = $6}
+       END {print best}' "$RESULTS")"
+  [[ -n "$MODE" ]] && echo "$PROGRAM: $MODE has the lowest cycles per packet in $RESULTS" >&2
+fi
+if [[ -z "$MODE" ]]; then
+  MODE="${MODES%% *}"
+  echo "$PROGRAM: using $MODE (possible modes: $MODES)" >&2
+fi
+
+if [[ "$MODE" != "default" ]]; then
+  echo "--xdp2tc=$MODE"
+fi
@@ -0,0 +1,814 @@
+/*
+ * AF_XDP traffic generator and sink, a stand-in for TRex on a single machine or a second NIC port.
+ *
+ * Usage: xsk_gen [-t THREADS] [-q RX_QUEUES] [-d DURATION] [-r RATE] [-v OFFSET:SIZE:MIN:MAX]...
+ *                [-k IP_OFFSET]... [-l] [-H HDR_FILE] [-n [-m MAX_ITERATIONS] [-p PDR] [-e PDR_ERROR]]
+ *                TX_IF[@NETNS] RX_IF[@NETNS] TEMPLATE
+ *
+ * The first frame of the pcap file TEMPLATE (e.g. written by scripts/loopback_gen.py pcap) is sent
+ * from queues 0..THREADS-1 (default 1) of TX_IF, one thread per queue, at RATE frames per second
+ * in total (default 0, as fast as possible) for DURATION seconds (default 10). Frames are received
+ * from queues 0..RX_QUEUES-1 (default THREADS) of RX_IF, which get an XDP program redirecting
+ * every frame to the sockets; an interface may be in a network namespace (gen0@psa_gen0).
+ * -v writes a counter going from MIN to MAX into the SIZE (1, 2 or 4) bytes at OFFSET of every
+ * frame, in network byte order (like a TRex STLVmFlowVar with op="inc"); all -v ranges step
+ * together. -k recomputes the checksum of the IPv4 header at IP_OFFSET after that.
+ * -l puts a timestamp into the last 16 bytes of every frame (keep them payload, see --size of
+ * loopback_gen.py) and records the one-way latency in a log-linear histogram with 3 significant
+ * digits; -H writes it as an HdrHistogram percentile distribution (in us) to HDR_FILE.
+ * -n runs a binary search of the rate with at most PDR % (default 0.1) loss, like the TRex ndr
+ * tool: the first trial runs at RATE (or as fast as possible, then its sent rate is the upper
+ * bound), the search stops after MAX_ITERATIONS (default 20) trials or when the bounds are less
+ * than PDR_ERROR % (default 0.05) of the rate apart.
+ * Prints one line per trial:
+ * <target pps> <sent pps> <received pps> <loss %> [<min> <p50> <p99> <p99.9> <max> latency in us]
+ * and the line of the highest rate that met PDR prefixed with "NDR" at the end of the search.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <bpf/bpf.h>
+#include <bpf/libbpf.h>
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+#define NUM_FRAMES 4096
+#define FRAME_SIZE 2048
+#define RING_SIZE 2048
+#define BATCH_SIZE 64
+#define MAX_QUEUES 64
+#define MAX_RANGES 8
+#define MAX_CHECKSUMS 4
+
+#define TIMESTAMP_MAGIC 0x50534154 /* "PSAT" */
+#define TIMESTAMP_SIZE 16
+
+/* HdrHistogram layout with 3 significant digits, values in ns up to 2^36 (~68 s) */
+#define HIST_SUB_BUCKET_HALF_MAGNITUDE 10
+#define HIST_SUB_BUCKET_HALF_COUNT (1 << HIST_SUB_BUCKET_HALF_MAGNITUDE)
+#define HIST_SUB_BUCKET_MASK (2 * HIST_SUB_BUCKET_HALF_COUNT - 1)
+#define HIST_MAX_VALUE ((1ULL << 36) - 1)
+#define HIST_BUCKETS (36 - HIST_SUB_BUCKET_HALF_MAGNITUDE)
+#define HIST_COUNTS ((HIST_BUCKETS + 1) * HIST_SUB_BUCKET_HALF_COUNT)
+
+struct ring {
+    __u32 *producer;
+    __u32 *consumer;
+    __u32 *flags;
+    void *desc;
+    __u32 mask;
+    __u32 size;
+};
+
+struct xsk {
+    int fd;
+    void *umem;
+    struct ring fill;
+    struct ring comp;
+    struct ring rx;
+    struct ring tx;
+};
+
+struct field_range {
+    unsigned offset;
+    unsigned size;
+    __u32 min;
+    __u32 max;
+};
+
+struct hist {
+    __u64 counts[HIST_COUNTS];
+    __u64 total;
+    __u64 min;
+    __u64 max;
+    double sum;
+    double sum_sq;
+};
+
+struct tx_worker {
+    pthread_t thread;
+    int id;
+    struct xsk xsk;
+    __u64 sent;
+    __u64 seq;
+};
+
+struct rx_worker {
+    pthread_t thread;
+    struct xsk xsk;
+    __u64 received;
+    struct hist hist;
+};
+
+struct trial {
+    double target;
+    double sent_pps;
+    double received_pps;
+    double loss;
+    struct hist hist;
+};
+
+static unsigned char template[FRAME_SIZE];
+static unsigned template_len;
+static struct field_range ranges[MAX_RANGES];
+static int num_ranges;
+static unsigned checksums[MAX_CHECKSUMS];
+static int num_checksums;
+static int latency;
+static int num_threads = 1;
+static double thread_rate;
+
+static volatile int tx_running;
+static volatile int rx_running;
+static volatile sig_atomic_t stopped;
+
+static __u64 now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void hist_reset(struct hist *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->min = HIST_MAX_VALUE;
+}
+
+static int hist_index(__u64 value)
+{
+    int bucket = 63 - __builtin_clzll(value | HIST_SUB_BUCKET_MASK) - HIST_SUB_BUCKET_HALF_MAGNITUDE;
+    int sub_bucket = value >> bucket;
+
+    return ((bucket + 1) << HIST_SUB_BUCKET_HALF_MAGNITUDE) + sub_bucket - HIST_SUB_BUCKET_HALF_COUNT;
+}
+
+/* highest value counted in slot index */
+static __u64 hist_value(int index)
+{
+    int bucket = (index >> HIST_SUB_BUCKET_HALF_MAGNITUDE) - 1;
+    __u64 sub_bucket = (index & (HIST_SUB_BUCKET_HALF_COUNT - 1)) + HIST_SUB_BUCKET_HALF_COUNT;
+
+    if (bucket < 0) {
+        sub_bucket -= HIST_SUB_BUCKET_HALF_COUNT;
+        bucket = 0;
+    }
+    return (sub_bucket << bucket) + (1ULL << bucket) - 1;
+}
+
+static void hist_record(struct hist *h, __u64 value)
+{
+    if (value > HIST_MAX_VALUE)
+        value = HIST_MAX_VALUE;
+    h->counts[hist_index(value)]++;
+    h->total++;
+    h->sum += value;
+    h->sum_sq += (double) value * value;
+    if (value < h->min)
+        h->min = value;
+    if (value > h->max)
+        h->max = value;
+}
+
+static void hist_add(struct hist *h, const struct hist *other)
+{
+    for (int i = 0; i < HIST_COUNTS; i++)
+        h->counts[i] += other->counts[i];
+    h->total += other->total;
+    h->sum += other->sum;
+    h->sum_sq += other->sum_sq;
+    if (other->min < h->min)
+        h->min = other->min;
+    if (other->max > h->max)
+        h->max = other->max;
+}
+
+static double hist_percentile(const struct hist *h, double percentile)
+{
+    __u64 count = 0;
+    __u64 target = (__u64) (percentile / 100 * h->total + 0.5);
+
+    if (target == 0)
+        target = 1;
+    for (int i = 0; i < HIST_COUNTS; i++) {
+        count += h->counts[i];
+        if (count >= target)
+            return hist_value(i) / 1000.0;
+    }
+    return h->max / 1000.0;
+}
+
+/* same format as hdr_percentiles_print() and HistogramLogProcessor, 5 ticks per half distance */
+static void hist_print(FILE *f, const struct hist *h)
+{
+    __u64 count = 0;
+    double next = 0;
+
+    fprintf(f, "%12s %12s %12s %12s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    for (int i = 0; i < HIST_COUNTS && count < h->total; i++) {
+        if (!h->counts[i])
+            continue;
+        count += h->counts[i];
+        double percentile = 100.0 * count / h->total;
+        while (percentile >= next && count < h->total) {
+            fprintf(f, "%12.3f %2.12f %10" PRIu64 " %14.2f\n", hist_value(i) / 1000.0,
+                    percentile / 100, (uint64_t) count, 1 / (1 - percentile / 100));
+            /* 5 * 2^(floor(log2(1 / (1 - next))) + 1) ticks per 100 % */
+            double ticks = 10;
+            for (double reciprocal = 100 / (100 - next); reciprocal >= 2; reciprocal /= 2)
+                ticks *= 2;
+            next += 100 / ticks;
+        }
+        if (count == h->total)
+            fprintf(f, "%12.3f %2.12f %10" PRIu64 "\n", hist_value(i) / 1000.0, 1.0, (uint64_t) count);
+    }
+    double mean = h->total ? h->sum / h->total : 0;
+    double variance = h->total ? h->sum_sq / h->total - mean * mean : 0;
+    fprintf(f, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean / 1000,
+            (variance > 0 ? sqrt(variance) : 0) / 1000);
+    fprintf(f, "#[Max     = %12.3f, Total count    = %12" PRIu64 "]\n", h->max / 1000.0, (uint64_t) h->total);
+    fprintf(f, "#[Buckets = %12d, SubBuckets     = %12d]\n", HIST_BUCKETS, 2 * HIST_SUB_BUCKET_HALF_COUNT);
+}
+
+static int set_netns(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    int ret = setns(fd, CLONE_NEWNET);
+    close(fd);
+    return ret;
+}
+
+/* Switch to the namespace of IFNAME[@NETNS] and return the ifindex. */
+static int enter_intf(const char *arg, char *ifname, size_t len)
+{
+    char path[256];
+    const char *at = strchr(arg, '@');
+
+    snprintf(ifname, len, "%.*s", at ? (int) (at - arg) : (int) strlen(arg), arg);
+    if (at) {
+        snprintf(path, sizeof(path), "/var/run/netns/%s", at + 1);
+        if (set_netns(path)) {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            return -1;
+        }
+    }
+    int ifindex = if_nametoindex(ifname);
+    if (!ifindex)
+        fprintf(stderr, "%s: %s\n", ifname, strerror(errno));
+    return ifindex ? ifindex : -1;
+}
+
+static int map_ring(int fd, struct ring *r, const struct xdp_ring_offset *off, __u32 size,
+                    size_t desc_size, off_t pgoff)
+{
+    void *map = mmap(NULL, off->desc + size * desc_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, pgoff);
+    if (map == MAP_FAILED)
+        return -1;
+    r->producer = map + off->producer;
+    r->consumer = map + off->consumer;
+    r->flags = map + off->flags;
+    r->desc = map + off->desc;
+    r->size = size;
+    r->mask = size - 1;
+    return 0;
+}
+
+/* AF_XDP socket with its own UMEM bound to ifindex/queue, with an RX (rx != 0) or a TX ring. */
+static int xsk_open(struct xsk *xsk, int ifindex, int queue, int rx)
+{
+    struct xdp_umem_reg reg = {
+        .len = NUM_FRAMES * FRAME_SIZE,
+        .chunk_size = FRAME_SIZE,
+    };
+    struct xdp_mmap_offsets off;
+    socklen_t optlen = sizeof(off);
+    int frames = NUM_FRAMES;
+    int ring_size = RING_SIZE;
+
+    memset(xsk, 0, sizeof(*xsk));
+    xsk->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (xsk->fd < 0)
+        return -1;
+    xsk->umem = mmap(NULL, reg.len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (xsk->umem == MAP_FAILED)
+        return -1;
+    reg.addr = (__u64) (unsigned long) xsk->umem;
+
+    if (setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) ||
+        setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_FILL_RING, &frames, sizeof(frames)) ||
+        setsockopt(xsk->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING, &frames, sizeof(frames)) ||
+        setsockopt(xsk->fd, SOL_XDP, rx ? XDP_RX_RING : XDP_TX_RING, &ring_size, sizeof(ring_size)) ||
+        getsockopt(xsk->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen))
+        return -1;
+
+    if (map_ring(xsk->fd, &xsk->fill, &off.fr, NUM_FRAMES, sizeof(__u64), XDP_UMEM_PGOFF_FILL_RING) ||
+        map_ring(xsk->fd, &xsk->comp, &off.cr, NUM_FRAMES, sizeof(__u64), XDP_UMEM_PGOFF_COMPLETION_RING))
+        return -1;
+    if (rx ? map_ring(xsk->fd, &xsk->rx, &off.rx, RING_SIZE, sizeof(struct xdp_desc), XDP_PGOFF_RX_RING) :
+             map_ring(xsk->fd, &xsk->tx, &off.tx, RING_SIZE, sizeof(struct xdp_desc), XDP_PGOFF_TX_RING))
+        return -1;
+
+    if (rx) {
+        /* the kernel owns all frames of a receiving socket */
+        __u64 *addrs = xsk->fill.desc;
+        for (int i = 0; i < NUM_FRAMES; i++)
+            addrs[i] = (__u64) i * FRAME_SIZE;
+        __atomic_store_n(xsk->fill.producer, NUM_FRAMES, __ATOMIC_RELEASE);
+    } else {
+        for (int i = 0; i < NUM_FRAMES; i++)
+            memcpy(xsk->umem + (size_t) i * FRAME_SIZE, template, template_len);
+    }
+
+    struct sockaddr_xdp sxdp = {
+        .sxdp_family = AF_XDP,
+        .sxdp_ifindex = ifindex,
+        .sxdp_queue_id = queue,
+        .sxdp_flags = XDP_USE_NEED_WAKEUP,
+    };
+    return bind(xsk->fd, (struct sockaddr *) &sxdp, sizeof(sxdp));
+}
+
+/* XDP program redirecting every frame to the socket of its RX queue. */
+static int load_redirect_prog(int xsks_fd)
+{
+    struct bpf_insn insns[] = {
+        /* r2 = ctx->rx_queue_index */
+        { .code = BPF_LDX | BPF_MEM | BPF_W, .dst_reg = BPF_REG_2, .src_reg = BPF_REG_1,
+          .off = offsetof(struct xdp_md, rx_queue_index) },
+        /* r1 = xsks */
+        { .code = BPF_LD | BPF_DW | BPF_IMM, .dst_reg = BPF_REG_1, .src_reg = BPF_PSEUDO_MAP_FD,
+          .imm = xsks_fd },
+        { 0 },
+        /* r3 = XDP_PASS, the action if the queue has no socket */
+        { .code = BPF_ALU64 | BPF_MOV | BPF_K, .dst_reg = BPF_REG_3, .imm = XDP_PASS },
+        { .code = BPF_JMP | BPF_CALL, .imm = BPF_FUNC_redirect_map },
+        { .code = BPF_JMP | BPF_EXIT },
+    };
+
+    return bpf_prog_load(BPF_PROG_TYPE_XDP, "xsk_gen_redir", "GPL", insns,
+                         sizeof(insns) / sizeof(insns[0]), NULL);
+}
+
+static void ip_checksum(unsigned char *ip)
+{
+    unsigned len = (ip[0] & 0xf) * 4;
+    __u32 sum = 0;
+
+    ip[10] = ip[11] = 0;
+    for (unsigned i = 0; i < len; i += 2)
+        sum += (ip[i] << 8) | ip[i + 1];
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    sum = ~sum & 0xffff;
+    ip[10] = sum >> 8;
+    ip[11] = sum & 0xff;
+}
+
+static void write_fields(unsigned char *frame, __u64 seq)
+{
+    for (int i = 0; i < num_ranges; i++) {
+        const struct field_range *r = &ranges[i];
+        __u32 value = r->min + seq % ((__u64) r->max - r->min + 1);
+        for (unsigned b = 0; b < r->size; b++)
+            frame[r->offset + b] = value >> (8 * (r->size - 1 - b));
+    }
+    for (int i = 0; i < num_checksums; i++)
+        ip_checksum(frame + checksums[i]);
+}
+
+static void *tx_loop(void *arg)
+{
+    struct tx_worker *w = arg;
+    struct xsk *xsk = &w->xsk;
+    __u32 outstanding = 0;
+    __u32 next_frame = 0;
+    __u64 interval = thread_rate > 0 ? BATCH_SIZE * 1e9 / thread_rate : 0;
+    __u64 next_batch = now_ns();
+
+    w->sent = 0;
+    while (tx_running) {
+        /* frames complete in order, so they are reused round robin */
+        __u32 comp_prod = __atomic_load_n(xsk->comp.producer, __ATOMIC_ACQUIRE);
+        __u32 done = comp_prod - *xsk->comp.consumer;
+        if (done) {
+            __atomic_store_n(xsk->comp.consumer, comp_prod, __ATOMIC_RELEASE);
+            outstanding -= done;
+        }
+
+        __u64 now = interval ? now_ns() : 0;
+        if (interval && now < next_batch)
+            continue;
+
+        __u32 tx_prod = *xsk->tx.producer;
+        __u32 tx_free = xsk->tx.size - (tx_prod - __atomic_load_n(xsk->tx.consumer, __ATOMIC_ACQUIRE));
+        __u32 n = BATCH_SIZE;
+        if (n > tx_free)
+            n = tx_free;
+        if (n > NUM_FRAMES - outstanding)
+            n = NUM_FRAMES - outstanding;
+        if (n == 0) {
+            if (*xsk->tx.flags & XDP_RING_NEED_WAKEUP)
+                sendto(xsk->fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+            continue;
+        }
+
+        /* one timestamp per batch */
+        __u64 ts = latency ? now_ns() : 0;
+        struct xdp_desc *descs = xsk->tx.desc;
+        for (__u32 i = 0; i < n; i++) {
+            __u64 addr = (__u64) next_frame * FRAME_SIZE;
+            unsigned char *frame = xsk->umem + addr;
+            next_frame = (next_frame + 1) % NUM_FRAMES;
+
+            write_fields(frame, w->seq * num_threads + w->id);
+            if (latency) {
+                __u32 *trailer = (__u32 *) (frame + template_len - TIMESTAMP_SIZE);
+                trailer[0] = htonl(TIMESTAMP_MAGIC);
+                trailer[1] = w->seq;
+                memcpy(&trailer[2], &ts, sizeof(ts));
+            }
+            w->seq++;
+
+            struct xdp_desc *desc = &descs[(tx_prod + i) & xsk->tx.mask];
+            desc->addr = addr;
+            desc->len = template_len;
+            desc->options = 0;
+        }
+        __atomic_store_n(xsk->tx.producer, tx_prod + n, __ATOMIC_RELEASE);
+        if (*xsk->tx.flags & XDP_RING_NEED_WAKEUP)
+            sendto(xsk->fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+        outstanding += n;
+        w->sent += n;
+        if (interval)
+            next_batch = (next_batch + interval < now ? now : next_batch) + interval * n / BATCH_SIZE;
+    }
+    return NULL;
+}
+
+static void *rx_loop(void *arg)
+{
+    struct rx_worker *w = arg;
+    struct xsk *xsk = &w->xsk;
+    struct pollfd pfd = { .fd = xsk->fd, .events = POLLIN };
+
+    w->received = 0;
+    hist_reset(&w->hist);
+    while (rx_running) {
+        __u32 rx_prod = __atomic_load_n(xsk->rx.producer, __ATOMIC_ACQUIRE);
+        __u32 rx_cons = *xsk->rx.consumer;
+        __u32 n = rx_prod - rx_cons;
+        if (n == 0) {
+            if (*xsk->fill.flags & XDP_RING_NEED_WAKEUP)
+                recvfrom(xsk->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+            poll(&pfd, 1, 1);
+            continue;
+        }
+
+        __u64 now = latency ? now_ns() : 0;
+        const struct xdp_desc *descs = xsk->rx.desc;
+        __u64 *fill = xsk->fill.desc;
+        __u32 fill_prod = *xsk->fill.producer;
+        for (__u32 i = 0; i < n; i++) {
+            const struct xdp_desc *desc = &descs[(rx_cons + i) & xsk->rx.mask];
+            if (latency && desc->len >= TIMESTAMP_SIZE) {
+                const __u32 *trailer = (const __u32 *) (xsk->umem + desc->addr + desc->len - TIMESTAMP_SIZE);
+                __u64 ts;
+                memcpy(&ts, &trailer[2], sizeof(ts));
+                if (trailer[0] == htonl(TIMESTAMP_MAGIC) && ts <= now)
+                    hist_record(&w->hist, now - ts);
+            }
+            /* every frame goes back to the kernel, so the fill ring always has room */
+            fill[(fill_prod + i) & xsk->fill.mask] = desc->addr & ~(__u64) (FRAME_SIZE - 1);
+        }
+        __atomic_store_n(xsk->rx.consumer, rx_cons + n, __ATOMIC_RELEASE);
+        __atomic_store_n(xsk->fill.producer, fill_prod + n, __ATOMIC_RELEASE);
+        w->received += n;
+    }
+    return NULL;
+}
+
+static void stop(int sig)
+{
+    stopped = 1;
+    tx_running = 0;
+}
+
+static int run_trial(struct tx_worker *tx, struct rx_worker *rx, int rx_queues, double duration,
+                     double rate, struct trial *t)
+{
+    __u64 sent = 0, received = 0;
+
+    thread_rate = rate / num_threads;
+    rx_running = 1;
+    for (int i = 0; i < rx_queues; i++)
+        if (pthread_create(&rx[i].thread, NULL, rx_loop, &rx[i]))
+            return -1;
+    tx_running = 1;
+    __u64 start = now_ns();
+    for (int i = 0; i < num_threads; i++)
+        if (pthread_create(&tx[i].thread, NULL, tx_loop, &tx[i]))
+            return -1;
+    while (tx_running && now_ns() - start < duration * 1e9)
+        usleep(10000);
+    tx_running = 0;
+    for (int i = 0; i < num_threads; i++)
+        pthread_join(tx[i].thread, NULL);
+    double elapsed = (now_ns() - start) / 1e9;
+    /* let the last frames arrive */
+    usleep(200000);
+    rx_running = 0;
+
+    hist_reset(&t->hist);
+    for (int i = 0; i < rx_queues; i++) {
+        pthread_join(rx[i].thread, NULL);
+        received += rx[i].received;
+        hist_add(&t->hist, &rx[i].hist);
+    }
+    for (int i = 0; i < num_threads; i++)
+        sent += tx[i].sent;
+
+    t->target = rate;
+    t->sent_pps = sent / elapsed;
+    t->received_pps = received / elapsed;
+    t->loss = sent && received < sent ? 100.0 * (sent - received) / sent : 0;
+    return 0;
+}
+
+static void print_trial(const char *prefix, const struct trial *t)
+{
+    printf("%s%.0f %.0f %.0f %.4f", prefix, t->target, t->sent_pps, t->received_pps, t->loss);
+    if (latency)
+        printf(" %.2f %.2f %.2f %.2f %.2f", t->hist.total ? t->hist.min / 1000.0 : 0,
+               hist_percentile(&t->hist, 50), hist_percentile(&t->hist, 99),
+               hist_percentile(&t->hist, 99.9), t->hist.max / 1000.0);
+    printf("\n");
+    fflush(stdout);
+}
+
+static int read_template(const char *path)
+{
+    __u32 header[6], record[4];
+    FILE *f = fopen(path, "rb");
+    int ret = -1;
+
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (fread(header, sizeof(header), 1, f) != 1 || fread(record, sizeof(record), 1, f) != 1) {
+        fprintf(stderr, "%s: no frame\n", path);
+        goto out;
+    }
+    int swapped = header[0] == 0xd4c3b2a1 || header[0] == 0x4d3cb2a1;
+    if (!swapped && header[0] != 0xa1b2c3d4 && header[0] != 0xa1b23c4d) {
+        fprintf(stderr, "%s: not a pcap file\n", path);
+        goto out;
+    }
+    template_len = swapped ? __builtin_bswap32(record[2]) : record[2];
+    if (template_len > FRAME_SIZE || fread(template, template_len, 1, f) != 1) {
+        fprintf(stderr, "%s: bad frame of %u bytes\n", path, template_len);
+        goto out;
+    }
+    ret = 0;
+out:
+    fclose(f);
+    return ret;
+}
+
+static int parse_range(const char *arg)
+{
+    struct field_range *r = &ranges[num_ranges];
+    unsigned long long min, max;
+
+    if (num_ranges == MAX_RANGES ||
+        sscanf(arg, "%u:%u:%llu:%llu", &r->offset, &r->size, &min, &max) != 4 ||
+        (r->size != 1 && r->size != 2 && r->size != 4) || min > max || max >> (8 * r->size)) {
+        fprintf(stderr, "Bad field range %s\n", arg);
+        return -1;
+    }
+    r->min = min;
+    r->max = max;
+    num_ranges++;
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [-t THREADS] [-q RX_QUEUES] [-d DURATION] [-r RATE] [-v OFFSET:SIZE:MIN:MAX]...\n"
+                    "       [-k IP_OFFSET]... [-l] [-H HDR_FILE] [-n [-m MAX_ITERATIONS] [-p PDR] [-e PDR_ERROR]]\n"
+                    "       TX_IF[@NETNS] RX_IF[@NETNS] TEMPLATE\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    static struct tx_worker tx[MAX_QUEUES];
+    static struct rx_worker rx[MAX_QUEUES];
+    static struct trial trial, best;
+    char tx_name[IF_NAMESIZE], rx_name[IF_NAMESIZE];
+    int rx_queues = 0;
+    double duration = 10;
+    double rate = 0;
+    const char *hdr_file = NULL;
+    int ndr = 0;
+    int max_iterations = 20;
+    double pdr = 0.1;
+    double pdr_error = 0.05;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:q:d:r:v:k:lH:nm:p:e:")) != -1) {
+        switch (opt) {
+        case 't':
+            num_threads = atoi(optarg);
+            break;
+        case 'q':
+            rx_queues = atoi(optarg);
+            break;
+        case 'd':
+            duration = atof(optarg);
+            break;
+        case 'r':
+            rate = atof(optarg);
+            break;
+        case 'v':
+            if (parse_range(optarg))
+                return EINVAL;
+            break;
+        case 'k':
+            if (num_checksums == MAX_CHECKSUMS)
+                return EINVAL;
+            checksums[num_checksums++] = atoi(optarg);
+            break;
+        case 'l':
+            latency = 1;
+            break;
+        case 'H':
+            hdr_file = optarg;
+            break;
+        case 'n':
+            ndr = 1;
+            break;
+        case 'm':
+            max_iterations = atoi(optarg);
+            break;
+        case 'p':
+            pdr = atof(optarg);
+            break;
+        case 'e':
+            pdr_error = atof(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return EINVAL;
+        }
+    }
+    if (rx_queues == 0)
+        rx_queues = num_threads;
+    if (optind + 3 != argc || num_threads < 1 || num_threads > MAX_QUEUES ||
+        rx_queues < 1 || rx_queues > MAX_QUEUES) {
+        usage(argv[0]);
+        return EINVAL;
+    }
+    if (read_template(argv[optind + 2]))
+        return EINVAL;
+    if (latency && template_len < TIMESTAMP_SIZE) {
+        fprintf(stderr, "Frames of %u bytes have no room for timestamps\n", template_len);
+        return EINVAL;
+    }
+    for (int i = 0; i < num_ranges; i++) {
+        if (ranges[i].offset + ranges[i].size > template_len) {
+            fprintf(stderr, "Field range at %u is out of the frame\n", ranges[i].offset);
+            return EINVAL;
+        }
+    }
+    for (int i = 0; i < num_checksums; i++) {
+        if (checksums[i] + 20 > template_len ||
+            checksums[i] + (template[checksums[i]] & 0xf) * 4 > template_len) {
+            fprintf(stderr, "No IPv4 header at %u\n", checksums[i]);
+            return EINVAL;
+        }
+    }
+    /* the counter of the first frames */
+    write_fields(template, 0);
+
+    int own_ns = open("/proc/self/ns/net", O_RDONLY);
+    if (own_ns < 0) {
+        perror("/proc/self/ns/net");
+        return -1;
+    }
+
+    /* sockets stay in the namespace they were created in, threads do not need to switch */
+    int tx_ifindex = enter_intf(argv[optind], tx_name, sizeof(tx_name));
+    if (tx_ifindex < 0)
+        return -1;
+    for (int i = 0; i < num_threads; i++) {
+        tx[i].id = i;
+        if (xsk_open(&tx[i].xsk, tx_ifindex, i, 0)) {
+            fprintf(stderr, "%s queue %d: %s\n", tx_name, i, strerror(errno));
+            return -1;
+        }
+    }
+    if (setns(own_ns, CLONE_NEWNET)) {
+        perror("setns");
+        return -1;
+    }
+
+    int rx_ifindex = enter_intf(argv[optind + 1], rx_name, sizeof(rx_name));
+    if (rx_ifindex < 0)
+        return -1;
+    int xsks_fd = bpf_map_create(BPF_MAP_TYPE_XSKMAP, "xsk_gen_xsks", sizeof(__u32), sizeof(int),
+                                 MAX_QUEUES, NULL);
+    int prog_fd = xsks_fd < 0 ? -1 : load_redirect_prog(xsks_fd);
+    if (prog_fd < 0) {
+        fprintf(stderr, "Loading the XDP program: %s\n", strerror(errno));
+        return -1;
+    }
+    for (int i = 0; i < rx_queues; i++) {
+        __u32 queue = i;
+        if (xsk_open(&rx[i].xsk, rx_ifindex, i, 1) ||
+            bpf_map_update_elem(xsks_fd, &queue, &rx[i].xsk.fd, BPF_ANY)) {
+            fprintf(stderr, "%s queue %d: %s\n", rx_name, i, strerror(errno));
+            return -1;
+        }
+    }
+    __u32 xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST | XDP_FLAGS_DRV_MODE;
+    if (bpf_xdp_attach(rx_ifindex, prog_fd, xdp_flags, NULL)) {
+        xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST | XDP_FLAGS_SKB_MODE;
+        if (bpf_xdp_attach(rx_ifindex, prog_fd, xdp_flags, NULL)) {
+            fprintf(stderr, "Attaching XDP to %s: %s\n", rx_name, strerror(errno));
+            return -1;
+        }
+    }
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    int ret = run_trial(tx, rx, rx_queues, duration, rate, &trial);
+    if (ret == 0)
+        print_trial("", &trial);
+    best = trial;
+    if (ret == 0 && ndr && trial.loss > pdr) {
+        /* the rate of the first trial is an upper bound, a lossless rate is the lower one */
+        double high = rate > 0 ? rate : trial.sent_pps;
+        double low = 0;
+        memset(&best, 0, sizeof(best));
+        hist_reset(&best.hist);
+        for (int i = 1; i < max_iterations && !stopped && high - low > high * pdr_error / 100; i++) {
+            double target = (low + high) / 2;
+            if ((ret = run_trial(tx, rx, rx_queues, duration, target, &trial)))
+                break;
+            print_trial("", &trial);
+            if (trial.loss <= pdr) {
+                low = target;
+                best = trial;
+            } else {
+                high = target;
+            }
+        }
+    }
+    if (ret == 0 && ndr)
+        print_trial("NDR ", &best);
+    if (ret == 0 && hdr_file) {
+        FILE *f = fopen(hdr_file, "w");
+        if (f) {
+            hist_print(f, &best.hist);
+            fclose(f);
+        } else {
+            fprintf(stderr, "%s: %s\n", hdr_file, strerror(errno));
+        }
+    }
+
+    bpf_xdp_detach(rx_ifindex, xdp_flags & ~XDP_FLAGS_UPDATE_IF_NOEXIST, NULL);
+    close(prog_fd);
+    close(xsks_fd);
+    close(own_ns);
+    return ret;
+}
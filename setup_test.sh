@@ -14,8 +14,13 @@ function print_help() {
   echo "-c|--cmd           Path to the file containing runtime configuration for P4 tables/BPF maps."
   echo "-q|--queues        Set number of RX/TX queues per NIC (default 1)."
   echo "-C|--core          CPU core that will be pinned to interfaces."
-  echo "--p4args           P4ARGS for PSA-eBPF."
+  echo "--p4args           P4ARGS for PSA-eBPF (--xdp2tc=auto selects the XDP->TC handoff mode with scripts/xdp2tc_mode.sh)."
+  echo "--xdp2tc-results   Cycles measured by scripts/xdp2tc_cycles.sh, used to select the mode for --xdp2tc=auto."
+  echo "--cflags           Extra flags (e.g. -DNAME=VALUE) passed to clang when compiling the BPF object."
+  echo "--bulk             Install 'psabpf-ctl table add' entries from the -c file with batched map updates."
   echo "--target           target subsystem (default empty, possible values: psa-ebpf, p4-dpdk, bmv2-psa)"
+  echo "--loopback         Single machine testbed: ports are veth pairs whose peers are in network namespaces psa_gen0/psa_gen1,"
+  echo "                   traffic is generated by scripts/loopback_gen.py (not supported by p4-dpdk)."
   echo "--help             Print this message."
   echo ""
   echo "PROGRAM:           P4 file (will be compiled by PSA-eBPF and then clang) or C file (will be compiled just by clang). (mandatory)"
@@ -82,11 +87,29 @@ while [[ $# -gt 0 ]]; do
       shift # past argument
       shift # past value
       ;;
+     --cflags)
+      EXTRA_CFLAGS="$2"
+      shift # past argument
+      shift # past value
+      ;;
+     --bulk)
+      BULK_LOAD=1
+      shift # past argument
+      ;;
+     --xdp2tc-results)
+      XDP2TC_RESULTS="$2"
+      shift # past argument
+      shift # past value
+      ;;
      --target)
       TARGET="$2"
       shift # past argument
       shift # past value
       ;;
+     --loopback)
+      LOOPBACK=1
+      shift # past argument
+      ;;
     *)    # unknown option
       POSITIONAL+=("$1") # save it in an array for later
       shift # past argument
@@ -107,8 +130,41 @@ fi
 
 set -o allexport
 source $ENV
+export NUM_QUEUES
 #set +o allexport
 
+# Replace the ports of ENV with veth pairs. The generator side (gen0, gen1) of each pair is put in
+# its own network namespace, so that frames sent by gen0 reach gen1 only through the DUT.
+function loopback_init() {
+  for i in 0 1; do
+    ip netns del psa_gen$i 2> /dev/null
+    ip netns add psa_gen$i
+    ip link add psa_lb$i numtxqueues $NUM_QUEUES numrxqueues $NUM_QUEUES type veth \
+        peer name gen$i numtxqueues $NUM_QUEUES numrxqueues $NUM_QUEUES netns psa_gen$i
+    ip netns exec psa_gen$i sysctl -qw net.ipv6.conf.gen$i.disable_ipv6=1
+    # room for encapsulation (e.g. VXLAN) done by the DUT
+    ip -n psa_gen$i link set dev gen$i mtu 9000 up
+    # frames redirected by XDP to psa_lb$i are received by the NAPI of gen$i, enabled by GRO
+    ip netns exec psa_gen$i ethtool -K gen$i gro on
+  done
+  PORT0_NAME=psa_lb0
+  PORT1_NAME=psa_lb1
+  PORT0_INDEX=$(cat /sys/class/net/psa_lb0/ifindex)
+  PORT1_INDEX=$(cat /sys/class/net/psa_lb1/ifindex)
+  DUT_MAC0=$(cat /sys/class/net/psa_lb0/address)
+  DUT_MAC1=$(cat /sys/class/net/psa_lb1/address)
+  GENERATOR_MAC0=$(ip netns exec psa_gen0 cat /sys/class/net/gen0/address)
+  GENERATOR_MAC1=$(ip netns exec psa_gen1 cat /sys/class/net/gen1/address)
+}
+
+if [[ -n "$LOOPBACK" ]]; then
+  if [[ $TARGET == "p4-dpdk" ]]; then
+    echo "--loopback is not supported by p4-dpdk"
+    exit 1
+  fi
+  loopback_init
+fi
+
 echo $PORT1_NAME
 declare -a INTERFACES=("$PORT0_NAME" "$PORT1_NAME")
 
@@ -125,7 +181,7 @@ declare -a RECIRC_PORT_ID=$(ip -o link | awk '$2 == "psa_recirc:" {print $1}' |
 # Trace all command from this point
 #set -x
 
-declare -a ARGS="-DPSA_PORT_RECIRCULATE=$RECIRC_PORT_ID"
+declare -a ARGS="-DPSA_PORT_RECIRCULATE=$RECIRC_PORT_ID $EXTRA_CFLAGS"
 
 function dpdk_init_pipeline() {
   $DPDK_REPO/usertools/dpdk-devbind.py -u $PORT0_PCI_DEV
@@ -190,6 +246,11 @@ elif [[ $PROGRAM == *.p4 && $TARGET == "p4-dpdk" ]]; then
   fi
   exit 0
 elif [[ $PROGRAM == *.p4 ]]; then
+  if [[ $P4ARGS == *"--xdp2tc=auto"* ]]; then
+    XDP2TC="$(bash scripts/xdp2tc_mode.sh -p "${P4ARGS/--xdp2tc=auto/}" ${XDP2TC_RESULTS:+-r "$XDP2TC_RESULTS"} \
+        "$PROGRAM" "${INTERFACES[@]}")"
+    P4ARGS="${P4ARGS/--xdp2tc=auto/$XDP2TC}"
+  fi
   echo "Compiling data plane program.. $PROGRAM"
   make -f $P4C_REPO/backends/ebpf/runtime/kernel.mk BPFOBJ=out.o \
       P4FILE=$PROGRAM ARGS="$ARGS" P4ARGS="$P4ARGS" psa
@@ -220,12 +281,14 @@ for intf in "${INTERFACES[@]}" ; do
 
   ifconfig "$intf" promisc
   ifconfig "$intf" mtu 1500 up
-  ethtool -L "$intf" combined $NUM_QUEUES
-  ethtool -G "$intf" tx 4096
-  ethtool -G "$intf" rx 4096
+  if [[ -z "$LOOPBACK" ]]; then
+    ethtool -L "$intf" combined $NUM_QUEUES
+    ethtool -G "$intf" tx 4096
+    ethtool -G "$intf" rx 4096
+    ethtool -A "$intf" rx off tx off
+  fi
   ethtool -K "$intf" txvlan off
   ethtool -K "$intf" rxvlan off
-  ethtool -A "$intf" rx off tx off
 
   if [[ $PROGRAM == *.p4 && $TARGET == "psa-ebpf" ]]; then
       psabpf-ctl pipeline add-port id 99 "$intf"
@@ -236,7 +299,9 @@ for intf in "${INTERFACES[@]}" ; do
   fi
 
   # by default, pin IRQ to 3rd CPU core
-  bash scripts/set_irq_affinity.sh $CORE "$intf"
+  if [[ -z "$LOOPBACK" ]]; then
+    bash scripts/set_irq_affinity.sh $CORE "$intf"
+  fi
 done
 
 if [[ $TARGET == "p4-dpdk" || $TARGET == "bmv2-psa"  ]]; then
@@ -247,7 +312,11 @@ fi
 echo "Installing table entries.. Looking for $COMMANDS_FILE"
 if [[ -n "$COMMANDS_FILE" ]]; then
    cat $COMMANDS_FILE
-   bash $COMMANDS_FILE
+   if [[ -n "$BULK_LOAD" ]]; then
+     bash scripts/table_load.sh $COMMANDS_FILE
+   else
+     bash $COMMANDS_FILE
+   fi
    echo -e "\nTable entries successfully installed!"
 else
    echo "File with table entries not provided"
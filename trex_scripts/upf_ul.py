@@ -4,15 +4,25 @@ from scapy.contrib.gtp import *
 class STLS1(object):
 
 
-    def create_stream (self,  packet_len):
+    def create_stream (self,  packet_len, flows):
         size = packet_len - 4
         packet = Ether()/IP(src="172.20.16.99",dst="172.20.16.105")/UDP(dport=2152)/GTP_U_Header(teid=1234)/IP(src="10.10.10.10",dst="192.168.2.21",version=4,id=0xFFFF)/UDP(sport=99,dport=99)
         pad = max(0, size - len(packet)) * 'x'
-        pkt = STLPktBuilder(pkt = packet/pad, vm = [])
+        vm = []
+        if flows > 1:
+            # outer UDP source port spreads flows over RX queues (RSS),
+            # inner destination address makes each flow a distinct table cache key
+            vm = STLScVmRaw( [ STLVmFlowVar(name="flow", min_value=0, max_value=flows - 1, size=2, op="inc"),
+                               STLVmWrFlowVar(fv_name="flow", pkt_offset="UDP.sport", add_val=1024),
+                               STLVmWrFlowVar(fv_name="flow", pkt_offset="IP:1.dst", offset_fixup=2),
+                               STLVmFixIpv4(offset="IP:1"),
+                             ]
+                           )
+        pkt = STLPktBuilder(pkt = packet/pad, vm = vm)
         return STLStream(packet = pkt, mode = STLTXCont())
 
-    def get_streams (self, direction = 0,  packet_len=64, **kwargs):
-        return [ self.create_stream(packet_len) ]
+    def get_streams (self, direction = 0,  packet_len=64, flows=1, **kwargs):
+        return [ self.create_stream(packet_len, int(flows)) ]
 
 
 # dynamic load - used for trex console or simulator